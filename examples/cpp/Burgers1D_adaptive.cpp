@@ -0,0 +1,70 @@
+/**
+ * Solving the 1D inviscid Burgers' equation with adaptive time stepping
+ *
+ * Equation: ∂U/∂t + ∂(U²/2)/∂x = 0  (conservative form)
+ * Domain:   x ∈ [-15, 15] with m = 300 grid cells
+ * Time:     Simulated until t = 10.0
+ * Initial Condition: U(x,0) = exp(-x² / 50)
+ *
+ * Same discretization as Burgers1D.cpp, but instead of a fixed dt = dx the
+ * Dormand-Prince 5(4) pair picks the step size from an error estimate, so it
+ * takes the largest step the tolerance and stability allow.
+ */
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include "mole.h"
+
+int main() {
+    constexpr double west = -15.0;
+    constexpr double east = 15.0;
+    constexpr int k = 2;
+    constexpr int m = 300;
+    constexpr double t = 10.0;
+
+    const double dx = (east - west) / m;
+
+    Divergence D(k, m, dx);
+    Interpol I(m, 1.0);
+    sp_mat DI = D * I;
+
+    // Spatial grid (including ghost cells)
+    arma::vec xgrid(m + 2);
+    xgrid(0) = west;
+    xgrid(m + 1) = east;
+    for (int i = 1; i <= m; ++i) {
+        xgrid(i) = west + (i - 0.5) * dx;
+    }
+
+    // Initial condition
+    arma::vec U = arma::exp(-arma::square(xgrid) / 50.0);
+
+    // dU/dt = -D*I*(U^2)/2, with a buffer for U^2 so it does not allocate
+    arma::vec flux(m + 2);
+    Integrator::RHS product = Integrator::linear(DI);
+    Integrator::RHS rhs = [&](Real time, const arma::vec &u, arma::vec &du) {
+        flux = arma::square(u);
+        product(time, flux, du);
+        du *= -0.5;
+    };
+
+    AdaptiveIntegrator integrator(AdaptiveIntegrator::DORMAND_PRINCE, rhs, 1e-6, 1e-8);
+
+    double time = 0;
+    for (int frame = 1; frame <= 5; ++frame) {
+        double next = frame * t / 5;
+        AdaptiveStats stats = integrator.integrate(time, next, U);
+        time = next;
+
+        std::cout << "Time: " << time
+                  << ", Trapz Area: " << Utils::trapz(xgrid, U)
+                  << ", U_min: " << U.min()
+                  << ", U_max: " << U.max()
+                  << ", steps: " << stats.accepted
+                  << " (" << stats.rejected << " rejected)"
+                  << ", dt in [" << stats.dt_min << ", " << stats.dt_max << "]"
+                  << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,66 @@
+/**
+ * @file Schrodinger2D_expmv.cpp
+ * @brief Propagates a 2D particle in a box with the Krylov exponential propagator.
+ *
+ * Solves i psi_t = H psi, H = -0.5 * Laplacian with Dirichlet boundaries, for the (nx, ny)
+ * eigenstate of Schrodinger2D.cpp. Instead of many small steps, psi(t) = exp(-itH) psi(0)
+ * is computed directly by Expmv in a few large steps with error control, and the result is
+ * compared with the exact phase rotation exp(-iEt) of the continuous eigenstate.
+ */
+
+#include "mole.h"
+#include <iostream>
+#include <cmath>
+
+using namespace arma;
+
+int main() {
+  double Lxy = 1.0;
+  int k = 2;  // Order of accuracy
+  int m = 50; // Grid points in x
+  int n = 50; // Grid points in y
+  int nx = 2; // Energy level in x
+  int ny = 2; // Energy level in y
+  double dx = Lxy / m;
+  double dy = Lxy / n;
+  double T = 1.0; // Final time
+  int frames = 4; // Outputs, one propagation each
+
+  // Staggered grids
+  vec xgrid = join_vert(vec({0}), linspace(dx / 2, Lxy - dx / 2, m), vec({Lxy}));
+  vec ygrid = join_vert(vec({0}), linspace(dy / 2, Lxy - dy / 2, n), vec({Lxy}));
+
+  mat X, Y;
+  Utils utils;
+  utils.meshgrid(xgrid, ygrid, X, Y);
+
+  // Hamiltonian with Dirichlet BC
+  Laplacian L(k, m, n, dx, dy);
+  RobinBC BC(k, m, dx, n, dy, 1, 0);
+  sp_mat H = -0.5 * (L + BC);
+
+  // Eigenstate, node (i, j) is entry j*(m+2)+i
+  double kx = nx * M_PI / Lxy, ky = ny * M_PI / Lxy;
+  double E = 0.5 * (kx * kx + ky * ky);
+  vec psi_re = vectorise(trans((2 / Lxy) * sin(kx * X) % sin(ky * Y)));
+  cx_vec psi0 = cx_vec(psi_re, zeros<vec>(psi_re.n_elem));
+
+  // exp(itA) with A = -H
+  Expmv propagator(-H, 1e-8);
+  cx_vec psi = psi0;
+
+  for (int frame = 1; frame <= frames; ++frame) {
+    double t = frame * T / frames;
+    ExpmvInfo info = propagator.apply(T / frames, psi, psi);
+
+    cx_vec exact = std::exp(std::complex<double>(0, -E * t)) * psi0;
+    std::cout << "t = " << t
+              << ", substeps: " << info.substeps
+              << ", products: " << info.products
+              << ", norm: " << norm(psi) / norm(psi0)
+              << ", difference to exp(-iEt) psi0: " << norm(psi - exact) / norm(psi0)
+              << std::endl;
+  }
+
+  return 0;
+}
@@ -16,11 +16,6 @@
 
 #define OUTPUT_FRAME_DATA 0
 
-// Helper for linear indexing in 3D arrays (0-based indexing)
-inline size_t idx3D(size_t i, size_t j, size_t k, size_t m, size_t n, size_t o) {
-    return i + (m+2)*j + (m+2)*(n+2)*k;
-}
-
 int main() {
     // Parameters
     unsigned short k = 2;
@@ -32,21 +27,17 @@ int main() {
     double c = 0.0, d = 51.0;
     double e = 0.0, f = 101.0;
 
-    double dx = (b - a) / m;
-    double dy = (d - c) / n;
-    double dz = (f - e) / o;
+    Grid3D grid(m, n, o, a, b, c, d, e, f);
+    double dx = grid.dx, dy = grid.dy, dz = grid.dz;
 
     // Construct operators
     sp_mat D = Divergence(k, m, n, o, dx, dy, dz);
     sp_mat G = Gradient(k, m, n, o, dx, dy, dz);
     sp_mat I = Interpol(m, n, o, 1, 1, 1);
 
-    size_t scalarSize = (m+2)*(n+2)*(o+2);
-    size_t vectorSize = G.n_rows;
-
     // Allocate fields
-    std::vector<double> V(vectorSize, 0.0);
-    vec C(scalarSize, fill::zeros);
+    vec V(grid.n_faces(), fill::zeros);
+    vec C(grid.n_centers(), fill::zeros);
 
     // Initial conditions
     int bottom = 10; 
@@ -55,37 +46,27 @@ int main() {
     int seal_idx = seal - 1;
     int seal5_idx = (seal + 5) - 1;
 
-    // Construct the velocity field
-    size_t yCount = m*(n+1)*o;
-    std::vector<double> y(yCount, 1.0);
-
-    // Apply shale conditions on velocity field
+    // Construct the velocity field, upward with shale conditions at the seals
+    Field Vy = grid.faces(V, 1);
+    Vy.as_vec().fill(1.0);
     for (int i_ = 0; i_ < (int)m; i_++) {
         for (int k_ = 0; k_ < (int)o; k_++) {
-            y[i_ + m*seal_idx + m*(n+1)*k_] = 0.0;
-            y[i_ + m*seal5_idx + m*(n+1)*k_] = 0.0;
-        }
-    }
-
-    // Assign y into V at the correct offset
-    size_t offset = (m+1)*n*o; 
-    for (size_t i_ = 0; i_ < yCount; ++i_) {
-        if (offset + i_ < V.size()) {
-            V[offset + i_] = y[i_];
+            Vy(i_, seal_idx, k_) = 0.0;
+            Vy(i_, seal5_idx, k_) = 0.0;
         }
     }
 
     // Set initial density
+    Field C0 = grid.centers(C);
     int mid_x = (int)std::ceil((m+2)/2.0) - 1; 
     int mid_z = (int)std::ceil((o+2)/2.0) - 1;
     for (int j = bottom - 1; j <= top - 1; j++) {
-        size_t idx = idx3D(mid_x, j, mid_z, m, n, o);
-        C(idx) = 1.0;
+        C0(mid_x, j, mid_z) = 1.0;
     }
 
     // Well indices where C=1
     std::vector<size_t> wellIndices;
-    for (size_t i_ = 0; i_ < scalarSize; ++i_) {
+    for (size_t i_ = 0; i_ < C.n_elem; ++i_) {
         if (C(i_) == 1.0) {
             wellIndices.push_back(i_);
         }
@@ -96,47 +77,43 @@ int main() {
     double porosity = 1.0;
     diff *= porosity;
 
-    // Build K
-    std::vector<double> K(vectorSize, diff);
-    std::vector<double> kk(yCount, diff);
+    // Build K, reduced on the y-faces of the seals
+    vec K(grid.n_faces());
+    K.fill(diff);
+    Field Ky = grid.faces(K, 1);
     for (int i_ = 0; i_ < (int)m; i_++) {
         for (int k_ = 0; k_ < (int)o; k_++) {
-            kk[i_ + m*seal_idx + m*(n+1)*k_] = diff/10.0;
-            kk[i_ + m*seal5_idx + m*(n+1)*k_] = diff/40.0;
-        }
-    }
-    for (size_t i_ = 0; i_ < yCount; ++i_) {
-        if (offset + i_ < K.size()) {
-            K[offset + i_] = kk[i_];
+            Ky(i_, seal_idx, k_) = diff/10.0;
+            Ky(i_, seal5_idx, k_) = diff/40.0;
         }
     }
 
     // Time step calculation
     double dt1 = dx*dx/(3*diff)/3.0;
-    double maxV = 0.0;
-    for (auto val : V) {
-        if (val > maxV) maxV = val;
-    }
+    double maxV = std::max(V.max(), 0.0);
     double dt2 = (maxV > 0.0) ? (dx/maxV)/3.0 : 1e-3;
-    double dt = std::min(dt1, dt2);
     int iters = 120;
 
-    // Convert V and K to arma::vec
-    arma::vec K_arma(K);
-    arma::vec V_arma(V);
+    // Final time of the original explicit run, 3*iters steps of min(dt1, dt2).
+    // Diffusion is implicit, so only the advective limit dt2 bounds the step
+    double tf = iters*3*std::min(dt1, dt2);
+    int steps = (int)std::ceil(tf/dt2);
+    double dt = tf/steps;
 
     arma::ivec offsets_vec(1);
     offsets_vec(0) = 0;
 
-    sp_mat Kdiag = spdiags(K_arma, offsets_vec, K_arma.n_elem, K_arma.n_elem);
-    sp_mat Vdiag = spdiags(V_arma, offsets_vec, V_arma.n_elem, V_arma.n_elem);
+    sp_mat Kdiag = spdiags(K, offsets_vec, K.n_elem, K.n_elem);
+    sp_mat Vdiag = spdiags(V, offsets_vec, V.n_elem, V.n_elem);
 
-    SizeMat size_identity(D.n_rows, D.n_rows);
-    sp_mat I_sp = speye(size_identity);
+    // Operators: diffusion L (implicit) and advection Dadv (explicit)
+    sp_mat L = D * Kdiag * G;
+    sp_mat Dadv = -D * Vdiag * I;
 
-    // Operators: L and Dadv
-    sp_mat L = dt * D * Kdiag * G + I_sp;
-    sp_mat Dadv = dt * D * Vdiag * I;
+    // IMEX Runge-Kutta, I - gamma*dt*L is set up once. The system is large
+    // and well conditioned for this dt, so an iterative backend is used
+    ImexIntegrator integrator(L, Integrator::linear(Dadv), dt,
+                              ImexIntegrator::ARS222, "bicgstab");
 
     #if OUTPUT_FRAME_DATA
     // Open a single file to store selected frames
@@ -148,29 +125,20 @@ int main() {
     #endif
 
     // Time-stepping loop
-    for (int i_ = 1; i_ <= iters*3; ++i_) {
-        // Diffusion step
-        vec Cnew = L * C;
-        for (auto w : wellIndices) {
-            Cnew(w) = 1.0;
-        }
-        C = Cnew;
-
-        // Advection step
-        vec Cadv = Dadv * C;
-        Cadv = C - Cadv;
+    for (int i_ = 1; i_ <= steps; ++i_) {
+        // Diffusion and advection step
+        integrator.step((i_ - 1)*dt, C);
         for (auto w : wellIndices) {
-            Cadv(w) = 1.0;
+            C(w) = 1.0;
         }
-        C = Cadv;
 
         #if OUTPUT_FRAME_DATA
         // Write only selected frames to a single file
         frameFile << "FRAME " << i_ << "\n";
+        Field Cv = grid.centers(C); // The step may have moved C
         for (int j = 0; j < (int)(n+2); j++) {
             for (int k_ = 0; k_ < (int)(o+2); k_++) {
-                size_t idx = idx3D(seal_idx, j, k_, m, n, o);
-                frameFile << C(idx);
+                frameFile << Cv(seal_idx, j, k_);
                 if (k_ < (int)(o+1)) frameFile << " ";
             }
             frameFile << "\n";
@@ -5,7 +5,7 @@
 #include "mole.h"
 #include <iostream>
 
-int main() {
+int main(int argc, char *argv[]) {
 
   int k = 6;             // Operators' order of accuracy
   Real a = 0;            // Left boundary
@@ -36,13 +36,10 @@ int main() {
   rhs(0) = 0;
   rhs(m + 1) = 2 * exp(1); // rhs(1) = 2e
 
-  // Solve the system of linear equations
-#ifdef EIGEN
-  // Use Eigen only if SuperLU (faster) is not available
-  vec sol = Utils::spsolve_eigen(L, rhs);
-#else
-  vec sol = spsolve(L, rhs); // Will use SuperLU
-#endif
+  // Solve the system of linear equations, the backend can be named on the
+  // command line (e.g. superlu, eigen-lu, gmres)
+  std::string backend = argc > 1 ? argv[1] : LinearSolver::default_backend();
+  vec sol = LinearSolver::spsolve(L, rhs, backend);
 
   // Print out the solution
   cout << sol;
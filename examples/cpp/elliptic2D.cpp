@@ -8,7 +8,7 @@
 #include "mole.h"
 #include <iostream>
 
-int main() {
+int main(int argc, char *argv[]) {
   int k = 2; // Operators' order of accuracy
   int m = 9; // Vertical resolution
   int n = 9; // Horizontal resolution
@@ -22,13 +22,10 @@ int main() {
   mat rhs(m + 2, n + 2, fill::zeros);
   rhs.row(0) = 100 * ones(1, n + 2); // Known value at the bottom boundary
 
-  // Solve the system of linear equations
-#ifdef EIGEN
-  // Use Eigen only if SuperLU (faster) is not available
-  vec sol = Utils::spsolve_eigen(L, vectorise(rhs));
-#else
-  vec sol = spsolve(L, vectorise(rhs)); // Will use SuperLU
-#endif
+  // Solve the system of linear equations, the backend can be named on the
+  // command line (e.g. superlu, eigen-lu, gmres)
+  std::string backend = argc > 1 ? argv[1] : LinearSolver::default_backend();
+  vec sol = LinearSolver::spsolve(L, vectorise(rhs), backend);
 
   // Print out the solution
   cout << reshape(sol, m + 2, n + 2);
@@ -27,7 +27,7 @@
 
 using namespace std;
 
-int main() {
+int main(int argc, char *argv[]) {
   constexpr int k = 2;  // Operators' order of accuracy
   constexpr int m = 5;  // Vertical resolution
   constexpr int n = 6;  // Horizontal resolution
@@ -55,14 +55,9 @@ int main() {
   arma::cube rhs(m + 2, n + 2, p + 2, arma::fill::zeros);
   rhs.slice(0).fill(100);  // Set boundary condition at z = 0
 
-  arma::vec sol;  // Declare sol
-
-#ifdef EIGEN
-    sol = arma::Utils::spsolve_eigen(L, arma::vectorise(rhs));
-#else
-    // Default to SuperLU if EIGEN is not defined
-    sol = arma::spsolve(L, arma::vectorise(rhs));
-#endif
+  // The backend can be named on the command line (e.g. superlu, eigen-lu)
+  string backend = argc > 1 ? argv[1] : LinearSolver::default_backend();
+  arma::vec sol = LinearSolver::spsolve(L, arma::vectorise(rhs), backend);
 
   // Reshape solution into a 3D cube
   arma::cube sol_cube(sol.memptr(), m + 2, n + 2, p + 2);
@@ -25,7 +25,7 @@ void saveVelocityForGnuplot(const mat& u, const mat& v,
 void generateGnuplotScript(const std::string& scriptFilename, double x_start,
                            double x_end, double y_start, double y_end);
 
-int main() {
+int main(int argc, char* argv[]) {
   // ----------------------- Domain and Grid Setup -----------------------
   constexpr double a = 0.0, b = 100.0;  // x-domain [0, 100] meters
   constexpr double c = 0.0, d = 20.0;   // y-domain [0, 20] meters
@@ -51,11 +51,12 @@ int main() {
   mat T = zeros<mat>(n + 2, m + 2);    // Temperature [°C]
   mat p = zeros<mat>(n + 2, m + 2);    // Pressure [N/m^2]
 
-  // Velocity fields:
-  // u-velocity (x-direction) defined on an n x (m+1) grid.
-  mat u = zeros<mat>(n, m + 1);
-  // v-velocity (y-direction) defined on an (n+1) x m grid.
-  mat v = zeros<mat>(n + 1, m);
+  // Velocity fields, packed as the rows of the Gradient: the (m+1) x n
+  // u-faces followed by the m x (n+1) v-faces, x fastest. They enter and
+  // leave the pressure projection without any reordering.
+  Grid2D grid(m, n, a, b, c, d);
+  FaceField<Grid2D> vel(grid), vel_star(grid);
+  vec p_vec(grid.n_centers(), fill::zeros);
 
   // ----------------------- Physical Parameters -----------------------
   constexpr double alpha = 1.664e-4;  // Thermal expansion coefficient (1/°C)
@@ -102,6 +103,12 @@ int main() {
   RobinBC BC(k, m, dx, n, dy, 0, 1);  // Neumann BC
   L = L + BC;
 
+  // L does not change, so it is factorised once for all the pressure solves.
+  // The backend can be named on the command line (e.g. superlu, eigen-lu)
+  std::unique_ptr<LinearSolver> poisson = LinearSolver::create(
+      argc > 1 ? argv[1] : LinearSolver::default_backend());
+  poisson->factorise(L);
+
   // Pre-multiply the gradient operator for pressure correction.
   G *= (-dt / rho_middle);
 
@@ -110,88 +117,67 @@ int main() {
 
   // ----------------------- Time-Stepping Loop -----------------------
   for (int t = 0; t < iterations; t++) {
-    // -- Predictor Step for u --
-    mat u_star = u;  // Temporary storage for predicted u
+    // Views of the packed velocities, indexed (x, y): u(j, i) is the u-face
+    // j of row i. Taken every step, as the storage may move.
+    Field u = vel.component(0), v = vel.component(1);
+    Field u_star = vel_star.component(0), v_star = vel_star.component(1);
 
-    // Apply No-slip Boundary Conditions to the predicted velocities
-    u_star.row(0).zeros();
-    u_star.row(u_star.n_rows - 1).zeros();
-    u_star.col(0).zeros();
-    u_star.col(u_star.n_cols - 1).zeros();
+    // -- Predictor Step for u --
+    // Apply No-slip Boundary Conditions to the predicted velocities, the
+    // loop below sets every other face
+    for (int j = 0; j < m + 1; j++) u_star(j, 0) = u_star(j, n - 1) = 0;
+    for (int i = 0; i < n; i++) u_star(0, i) = u_star(m, i) = 0;
 
     for (int i = 1; i < n - 1; i++) {
       for (int j = 1; j < m; j++) {
-        double d2u_dy2 = (u(i - 1, j) - 2 * u(i, j) + u(i + 1, j)) / (dy * dy);
-        double d2u_dx2 = (u(i, j - 1) - 2 * u(i, j) + u(i, j + 1)) / (dx * dx);
-        double udu_dx = (u(i, j) > 0) ? u(i, j) * (u(i, j) - u(i, j - 1)) / dx
-                                      : u(i, j) * (u(i, j + 1) - u(i, j)) / dx;
+        double d2u_dy2 = (u(j, i - 1) - 2 * u(j, i) + u(j, i + 1)) / (dy * dy);
+        double d2u_dx2 = (u(j - 1, i) - 2 * u(j, i) + u(j + 1, i)) / (dx * dx);
+        double udu_dx = (u(j, i) > 0) ? u(j, i) * (u(j, i) - u(j - 1, i)) / dx
+                                      : u(j, i) * (u(j + 1, i) - u(j, i)) / dx;
         double vij =
-            0.25 * (v(i, j) + v(i + 1, j - 1) + v(i + 1, j) + v(i, j - 1));
-        double vdu_dy = (vij > 0) ? vij * (u(i, j) - u(i - 1, j)) / dy
-                                  : vij * (u(i + 1, j) - u(i, j)) / dy;
-        u_star(i, j) =
-            u(i, j) + dt * (nu * (d2u_dy2 + d2u_dx2) - (udu_dx + vdu_dy));
+            0.25 * (v(j, i) + v(j - 1, i + 1) + v(j, i + 1) + v(j - 1, i));
+        double vdu_dy = (vij > 0) ? vij * (u(j, i) - u(j, i - 1)) / dy
+                                  : vij * (u(j, i + 1) - u(j, i)) / dy;
+        u_star(j, i) =
+            u(j, i) + dt * (nu * (d2u_dy2 + d2u_dx2) - (udu_dx + vdu_dy));
       }
     }
 
     // -- Predictor Step for v --
-    mat v_star = v;  // Temporary storage for predicted v
-
     // Apply No-slip Boundary Conditions to the predicted velocities
-    v_star.row(0).zeros();
-    v_star.row(v_star.n_rows - 1).zeros();
-    v_star.col(0).zeros();
-    v_star.col(v_star.n_cols - 1).zeros();
+    for (int j = 0; j < m; j++) v_star(j, 0) = v_star(j, n) = 0;
+    for (int i = 0; i < n + 1; i++) v_star(0, i) = v_star(m - 1, i) = 0;
 
     for (int i = 1; i < n; i++) {
       for (int j = 1; j < m - 1; j++) {  // v has m columns
-        double d2v_dy2 = (v(i - 1, j) - 2 * v(i, j) + v(i + 1, j)) / (dy * dy);
-        double d2v_dx2 = (v(i, j - 1) - 2 * v(i, j) + v(i, j + 1)) / (dx * dx);
-        double vdv_dy = (v(i, j) > 0) ? v(i, j) * (v(i, j) - v(i - 1, j)) / dy
-                                      : v(i, j) * (v(i + 1, j) - v(i, j)) / dy;
+        double d2v_dy2 = (v(j, i - 1) - 2 * v(j, i) + v(j, i + 1)) / (dy * dy);
+        double d2v_dx2 = (v(j - 1, i) - 2 * v(j, i) + v(j + 1, i)) / (dx * dx);
+        double vdv_dy = (v(j, i) > 0) ? v(j, i) * (v(j, i) - v(j, i - 1)) / dy
+                                      : v(j, i) * (v(j, i + 1) - v(j, i)) / dy;
         double uij =
-            0.25 * (u(i, j) + u(i - 1, j + 1) + u(i, j + 1) + u(i - 1, j));
-        double udv_dx = (uij > 0) ? uij * (v(i, j) - v(i, j - 1)) / dx
-                                  : uij * (v(i, j + 1) - v(i, j)) / dx;
-        v_star(i, j) =
-            v(i, j) + dt * (nu * (d2v_dy2 + d2v_dx2) - (vdv_dy + udv_dx) +
+            0.25 * (u(j, i) + u(j + 1, i - 1) + u(j + 1, i) + u(j, i - 1));
+        double udv_dx = (uij > 0) ? uij * (v(j, i) - v(j - 1, i)) / dx
+                                  : uij * (v(j + 1, i) - v(j, i)) / dx;
+        v_star(j, i) =
+            v(j, i) + dt * (nu * (d2v_dy2 + d2v_dx2) - (vdv_dy + udv_dx) +
                             g * alpha * (T(i, j) - T_middle));
       }
     }
 
     // -- Pressure Solve --
-    // Flatten the predicted velocities into vectors.
-    // Use transpose to match MATLAB's column-major order during vectorization
-    vec u_vec = vectorise(u_star.t());
-    vec v_vec = vectorise(v_star.t());
-    vec R = (rho_middle / dt) * join_cols(u_vec, v_vec);
-
-    // Calculate the right-hand side for the pressure Poisson equation
-    vec b = D * R;  // This is the divergence of the predicted velocity field
+    // The divergence of the predicted velocity field, already packed in the
+    // operator's order
+    vec rhs = D * vel_star.values;
+    rhs *= rho_middle / dt;
 
     // Solve the pressure Poisson equation
-    vec p_vec;
-#ifdef EIGEN
-    p_vec = Utils::spsolve_eigen(L, b);
-#else
-    // Default to SuperLU if EIGEN is not defined
-    p_vec = spsolve(L, b);
-#endif
-
-    // Reshape the solution vector back into a matrix
-    p = reshape(p_vec, m + 2, n + 2).t();
+    p_vec = poisson->solve(rhs);
 
     // -- Corrector Step --
-    // Update velocities by adding the pressure gradient, similar to MATLAB's u
-    // = u_s+G(1:u_length, :)*p;
-    int tot_u = u_vec.n_elem;
-    vec p_grad = G * p_vec;
-    vec p_grad_u = p_grad.rows(0, tot_u - 1);
-    vec p_grad_v = p_grad.rows(tot_u, p_grad.n_rows - 1);
-
-    // Make sure to reshape in the same order that was used when flattening
-    u = reshape(u_vec + p_grad_u, m + 1, n).t();
-    v = reshape(v_vec + p_grad_v, m, n + 1).t();
+    // Update velocities by adding the pressure gradient, as MATLAB's
+    // u = u_s + G*p. Updated in place, so the views u and v stay valid.
+    vel.values = vel_star.values;
+    vel.values += G * p_vec;
 
     // -- Advection of Temperature --
     // Implement a simple upwind differencing scheme for temperature advection
@@ -200,8 +186,8 @@ int main() {
     for (int i = 1; i < n + 1; i++) {
       for (int j = 1; j < m + 1; j++) {
         // Interpolate velocities to cell centers
-        double u_ij = 0.5 * (u(i - 1, j) + u(i - 1, j - 1));
-        double v_ij = 0.5 * (v(i, j - 1) + v(i - 1, j - 1));
+        double u_ij = 0.5 * (u(j, i - 1) + u(j - 1, i - 1));
+        double v_ij = 0.5 * (v(j - 1, i) + v(j - 1, i - 1));
 
         // Calculate upwind temperature gradients
         double dT_dx, dT_dy;
@@ -246,6 +232,11 @@ int main() {
   }
 
   // ----------------------- Post-Processing -----------------------
+  // Back to (y, x) arrays for the output
+  p = reshape(p_vec, m + 2, n + 2).t();
+  mat u = vel.component(0).as_mat().t();
+  mat v = vel.component(1).as_mat().t();
+
   // Recompute the density from the temperature field using the equation of
   // state
   rho = rho_middle * (1 - alpha * (T - T_middle));
@@ -0,0 +1,72 @@
+/**
+ * This example compares the double precision direct solvers with the mixed
+ * precision (float LU + double refinement) backend on the 3D BVP of
+ * elliptic3D.cpp, at a larger resolution.
+ *
+ * Usage: ./mixed_precision3D [cells per direction] [backends...]
+ */
+
+#include "mole.h"
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char *argv[]) {
+  int k = 2;                                  // Operators' order of accuracy
+  int m = argc > 1 ? std::stoi(argv[1]) : 40; // Cells per direction
+  Real dx = 1.0 / m;                          // Step size
+
+  std::vector<std::string> backends;
+  for (int i = 2; i < argc; ++i)
+    backends.push_back(argv[i]);
+
+  if (backends.empty()) {
+    for (const std::string &name : LinearSolver::backends())
+      if (name == "superlu" || name == "eigen-lu" || name == "mixed")
+        backends.push_back(name);
+  }
+
+  // Get mimetic operators
+  Laplacian L(k, m, m, m, dx, dx, dx);
+  RobinBC BC(k, m, dx, m, dx, m, dx, 1, 0); // Dirichlet BC
+  L = L + BC;
+
+  // u = 100 on the z = 0 face, zero on the others
+  cube rhs(m + 2, m + 2, m + 2, fill::zeros);
+  rhs.slice(0).fill(100);
+  vec b = vectorise(rhs);
+
+  cout << "Unknowns: " << L.n_rows << ", nonzeros: " << L.n_nonzero << "\n\n";
+  cout << std::left << std::setw(10) << "backend" << std::right
+       << std::setw(12) << "setup [s]" << std::setw(12) << "solve [s]"
+       << std::setw(14) << "factors [MB]" << std::setw(8) << "steps"
+       << std::setw(14) << "residual" << "\n";
+
+  vec reference;
+
+  for (const std::string &name : backends) {
+    auto solver = LinearSolver::create(name);
+    solver->factorise(L);
+    vec x = solver->solve(b);
+
+    const SolverStats &stats = solver->stats();
+    Real residual = norm(L * x - b) / norm(b);
+
+    cout << std::left << std::setw(10) << name << std::right << std::fixed
+         << std::setprecision(3) << std::setw(12) << stats.setup_time
+         << std::setw(12) << stats.solve_time << std::setw(14)
+         << stats.bytes / 1048576.0 << std::setw(8) << stats.iterations
+         << std::scientific << std::setprecision(2) << std::setw(14)
+         << residual;
+
+    if (reference.is_empty())
+      reference = x;
+    else
+      cout << "  (max difference " << max(abs(x - reference)) << ")";
+
+    cout << "\n";
+  }
+
+  return 0;
+}
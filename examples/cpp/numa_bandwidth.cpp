@@ -0,0 +1,152 @@
+/**
+ * Memory bandwidth per NUMA node with and without first-touch placement.
+ *
+ * Fields are made either the usual way, filled by the main thread so that
+ * all their pages land on its node, or with NUMA::zeros, whose pages are
+ * spread over the nodes as the triad's schedule(static) loop reads them. A STREAM
+ * triad a = b + s*c is timed per thread and the bandwidth of the threads
+ * of every node is added up. The 3D Laplacian is then applied with
+ * Armadillo SpMV and with NumaMatrix.
+ *
+ * Pin the threads so they stay where they touched their pages, e.g.
+ *   OMP_PROC_BIND=spread OMP_PLACES=cores ./numa_bandwidth
+ *
+ * Usage: ./numa_bandwidth [million entries] [cells per direction] [repeats]
+ */
+
+#include "mole.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Seconds spent by every thread on its static chunk of a triad, best of
+// repeats
+std::vector<Real> triad(vec &a, const vec &b, const vec &c, u32 repeats) {
+  int threads = 1;
+#ifdef _OPENMP
+  threads = omp_get_max_threads();
+#endif
+  std::vector<Real> best(threads, 0);
+  const long long n = a.n_elem;
+  Real *A = a.memptr();
+  const Real *B = b.memptr(), *C = c.memptr();
+
+  for (u32 r = 0; r < repeats; ++r) {
+#pragma omp parallel num_threads(threads)
+    {
+      int t = 0;
+#ifdef _OPENMP
+      t = omp_get_thread_num();
+#endif
+      wall_clock timer;
+#pragma omp barrier
+      timer.tic();
+#pragma omp for schedule(static) nowait
+      for (long long i = 0; i < n; ++i)
+        A[i] = B[i] + 3.0 * C[i];
+      Real s = timer.toc();
+      best[t] = r ? std::min(best[t], s) : s;
+    }
+  }
+  return best;
+}
+
+void report(const std::string &name, vec &a, const vec &b, const vec &c,
+            u32 repeats, const std::vector<int> &nodes) {
+  std::vector<Real> s = triad(a, b, c, repeats);
+
+  // Threads of a node finish together at best, so the slowest one counts
+  const int threads = s.size();
+  const Real bytes = 3.0 * sizeof(Real) * a.n_elem / threads;
+  std::map<int, std::pair<int, Real>> per_node; // Threads, slowest time
+  for (int t = 0; t < threads; ++t) {
+    auto &p = per_node[nodes[t]];
+    p.first++;
+    p.second = std::max(p.second, s[t]);
+  }
+
+  Real total = 0;
+  std::cout << name << "\n";
+  for (const auto &p : per_node) {
+    Real gbs = bytes * p.second.first / p.second.second / 1e9;
+    total += gbs;
+    std::cout << std::setw(10) << p.first << std::setw(10) << p.second.first
+              << std::fixed << std::setprecision(2) << std::setw(14) << gbs
+              << "\n";
+  }
+  std::cout << std::setw(10) << "all" << std::setw(10) << threads
+            << std::setw(14) << total << "\n";
+}
+
+// Seconds per y = A*x, best of repeats
+template <typename Apply> Real seconds(Apply apply, u32 repeats) {
+  wall_clock timer;
+  Real best = 0;
+  for (u32 r = 0; r < repeats; ++r) {
+    timer.tic();
+    apply();
+    Real t = timer.toc();
+    best = r ? std::min(best, t) : t;
+  }
+  return best;
+}
+
+int main(int argc, char *argv[]) {
+  uword n = (argc > 1 ? std::atof(argv[1]) : 64) * 1e6;
+  u32 m = argc > 2 ? std::atoi(argv[2]) : 100;
+  u32 repeats = argc > 3 ? std::atoi(argv[3]) : 5;
+
+  std::vector<int> nodes = NUMA::thread_nodes();
+  std::cout << nodes.size() << " threads on "
+            << std::set<int>(nodes.begin(), nodes.end()).size()
+            << " NUMA nodes, triad over " << n << " entries\n";
+  std::cout << std::setw(10) << "node" << std::setw(10) << "threads"
+            << std::setw(14) << "triad [GB/s]" << "\n";
+
+  {
+    // Every page written by the main thread
+    vec a(n, fill::zeros), b(n, fill::ones), c(n, fill::ones);
+    report("Filled by the main thread", a, b, c, repeats, nodes);
+  }
+  {
+    vec a = NUMA::zeros(n), b = NUMA::zeros(n), c = NUMA::zeros(n);
+    b += 1;
+    c += 1;
+    report("First touch (NUMA::zeros)", a, b, c, repeats, nodes);
+  }
+
+  // Bytes streamed by one SpMV: the matrix by rows, x and y
+  Real dx = 1.0 / m;
+  Laplacian L(2, m, m, m, dx, dx, dx);
+  NumaMatrix N(L);
+  const Real bytes = L.n_nonzero * (sizeof(Real) + sizeof(uword)) +
+                     (L.n_rows + 1) * sizeof(uword) +
+                     (L.n_rows + L.n_cols) * sizeof(Real);
+
+  vec x = NUMA::zeros(L.n_cols), y, z;
+  x += 1;
+  Real spmv = seconds([&] { y = L * x; }, repeats);
+  Real numa = seconds([&] { N.apply(x, z); }, repeats);
+
+  std::cout << "\nLaplacian, m = " << m << ", " << L.n_nonzero
+            << " nonzeros\n"
+            << std::setw(20) << "operator" << std::setw(12) << "time [s]"
+            << std::setw(10) << "GB/s" << "\n"
+            << std::setw(20) << "SpMV" << std::fixed << std::setprecision(4)
+            << std::setw(12) << spmv << std::setprecision(2) << std::setw(10)
+            << bytes / spmv / 1e9 << "\n"
+            << std::setw(20) << "NumaMatrix" << std::setprecision(4)
+            << std::setw(12) << numa << std::setprecision(2) << std::setw(10)
+            << bytes / numa / 1e9 << "\n";
+
+  return 0;
+}
@@ -23,11 +23,10 @@ int main() {
     vec solution(m + 2); 
     solution(0)=100;
     solution(m+1)=100;
-    vec k1(m+2); 
+    Integrator euler(Integrator::EULER, Integrator::linear(L));
     double t=t0;
     while (t <= tf) { //time integration with euler method. 
-        k1=L*(solution);
-        solution=solution+dt*k1;
+        euler.step(t, dt, solution);
         t=t+dt;
     }
     std::cout << solution;
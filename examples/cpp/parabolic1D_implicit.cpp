@@ -0,0 +1,50 @@
+#include <iostream>
+#include <math.h>
+#include "mole.h"
+/**
+ * This example solves the same heat equation as parabolic1D, u_t-alpha*u_xx=0 [with alpha=1] over [0,1],
+ * u(x,0)=0, u(0,t)=u(1,t)=100 for t in [0,1], but on a finer grid and with implicit time integrators.
+ * The explicit scheme needs dt<=dx^2/3, the implicit ones factor I-theta*dt*L once and reuse it every step,
+ * so they can take steps orders of magnitude larger.
+ */
+int main() {
+    int k=2; // Operators' order of accuracy
+    double tf=1; // final time
+    double a=0; // left boundary
+    double b=1; // right boundary
+    int m=200; // num of cells
+    double dx=(b-a)/m;
+    Laplacian L(k,m,dx);
+
+    vec u0(m+2, fill::zeros);
+    u0(0)=100;
+    u0(m+1)=100;
+
+    // Explicit reference
+    int explicit_steps=ceil((3*tf)/(dx*dx));
+    vec reference=u0;
+    Integrator euler(Integrator::EULER, Integrator::linear(L));
+    wall_clock timer;
+    timer.tic();
+    euler.integrate(0, tf, tf/explicit_steps, reference);
+    std::cout << "Forward Euler:  " << explicit_steps << " steps, " << timer.toc() << " s\n";
+
+    int steps=100;
+    double dt=tf/steps;
+
+    struct { const char *name; ImplicitIntegrator::Method method; double theta; } schemes[]={
+        {"Backward Euler", ImplicitIntegrator::THETA, 1.0},
+        {"Crank-Nicolson", ImplicitIntegrator::THETA, 0.5},
+        {"BDF2          ", ImplicitIntegrator::BDF2, 0.0}};
+
+    for (auto &scheme : schemes) {
+        vec u=u0;
+        timer.tic();
+        ImplicitIntegrator integrator(L, dt, scheme.method, scheme.theta);
+        integrator.integrate(0, steps, u);
+        std::cout << scheme.name << ":  " << steps << " steps, " << timer.toc() << " s, "
+                  << "max difference " << abs(u-reference).max() << "\n";
+    }
+
+    return 0;
+}
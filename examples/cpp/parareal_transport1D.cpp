@@ -0,0 +1,64 @@
+/**
+ * This example solves the advection-dispersion equation of transport1D.cpp,
+ * C_t = D*(dis*(G*C)) - D*(V % (I*C)), with the Parareal parallel-in-time method.
+ *
+ * The fine propagator uses fourth order operators and RK4 with small steps, the coarse
+ * one second order operators and SSP-RK2 with steps eight times larger. The fine solves
+ * of the time slices run concurrently, one per thread (set OMP_NUM_THREADS).
+ *
+ * Usage: ./parareal_transport1D [slices]
+ */
+
+#include "mole.h"
+#include <cstdlib>
+#include <iostream>
+
+// dC/dt = D*(dis*G*C) - D*(V % (I*C)) for operators of order k
+static Integrator::RHS transport(int k, int m, Real dx, Real dis, Real vel) {
+  Gradient G(k, m, dx);
+  Divergence D(k, m, dx);
+  Interpol I(m, 0.5);
+
+  sp_mat A = dis * D * G - vel * D * I;
+  return Integrator::linear(A);
+}
+
+int main(int argc, char *argv[]) {
+  int m = 200;           // Number of cells
+  Real a = 0;            // Left boundary
+  Real b = 130;          // Right boundary
+  Real dx = (b - a) / m; // Cell's width [m]
+  Real t = 4;            // Simulation time [years]
+  Real dis = 5 * 15;     // Hydrodynamic dispersion coefficient [m^2/year]
+  Real vel = 15;         // Pore-water flow velocity [m/year]
+  Real R = 2.5;          // Retardation
+  u32 slices = argc > 1 ? std::atoi(argv[1]) : 16;
+
+  // Retardation slows the whole process, as in transport1D
+  Real tf = t / R;
+  Real dt = 0.1 * dx * dx / dis;
+
+  Parareal::Propagator fine = Parareal::propagator(
+      Integrator::RK4, transport(4, m, dx, dis, vel), dt / 2);
+  Parareal::Propagator coarse = Parareal::propagator(
+      Integrator::SSPRK2, transport(2, m, dx, dis, vel), 4 * dt);
+
+  vec C(m + 2, fill::zeros);
+  C(0) = 1; // Displacing solution concentration [mmol/kgw]
+
+  Parareal parareal(coarse, fine, slices);
+  PararealInfo info = parareal.solve(0, tf, C, 1e-8);
+
+  std::cout << "Slices: " << slices
+            << ", estimated serial fine time: " << info.serial_time << " s\n";
+  for (size_t k = 0; k < info.history.size(); ++k) {
+    std::cout << "Iteration " << k + 1
+              << ": change " << info.history[k].change
+              << ", elapsed " << info.history[k].elapsed << " s"
+              << ", speedup " << info.history[k].speedup << "\n";
+  }
+  std::cout << (info.converged ? "Converged" : "Not converged")
+            << ", time in the coarse propagator: " << info.coarse_time << " s\n";
+
+  return 0;
+}
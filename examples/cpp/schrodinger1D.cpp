@@ -27,10 +27,8 @@ int main() {
   // Hamiltonian
   sp_mat H = -0.5 * (sp_mat)L + V;
 
-  cx_vec eigval;
-  eig_gen(eigval, (mat)H); // Compute eigenvalues
-
-  eigval = sort(eigval);
+  // Lowest eigenvalues, from a sparse shift-invert solver
+  cx_vec eigval = Eigensolver(H).eigenvalues(4);
 
   cout << "Energy levels = [ ";
   for (int i = 0; i < 4; ++i)
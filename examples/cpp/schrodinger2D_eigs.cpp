@@ -0,0 +1,52 @@
+/**
+ * This example uses MOLE to compute the lowest energy levels of the 2D
+ * quantum harmonic oscillator with a sparse eigensolver
+ */
+
+#include "mole.h"
+#include <iostream>
+
+int main() {
+
+  int k = 4;   // Operators' order of accuracy
+  Real a = -5; // Left and bottom boundaries
+  Real b = 5;  // Right and top boundaries
+  int m = 500; // Number of cells in x and y
+  Real dx = (b - a) / m; // Step size
+
+  // Staggered grid
+  vec grid(m + 2);
+  grid(0) = a;
+  grid.subvec(1, m) = linspace(a + dx / 2, b - dx / 2, m);
+  grid(m + 1) = b;
+
+  // Get mimetic Laplacian operator
+  Laplacian L(k, m, m, dx, dx);
+
+  mat X, Y;
+  Utils utils;
+  utils.meshgrid(grid, grid, X, Y);
+
+  sp_mat V((m + 2) * (m + 2), (m + 2) * (m + 2)); // Potential energy operator
+  V.diag(0) = vectorise(square(X) + square(Y));
+
+  // Hamiltonian
+  sp_mat H = -0.5 * (sp_mat)L + V;
+
+  // H is factorised once, only a (m+2)^2 x 20 basis is dense
+  Eigensolver eigs(H);
+
+  cx_vec eigval;
+  cx_mat eigvec;
+  EigenInfo info = eigs.solve(eigval, eigvec, 6);
+
+  cout << "Energy levels = [ ";
+  for (int i = 0; i < 6; ++i)
+    cout << real(eigval(i) / eigval(0)) << ' ';
+  cout << "]\n";
+
+  cout << "Converged " << info.converged << " eigenpairs after "
+       << info.products << " solves\n";
+
+  return 0;
+}
@@ -6,11 +6,6 @@
 
 using namespace std;
 
-// Force function
-arma::vec calculateForce(const Laplacian& L, const arma::vec& x, const double c_squared) {
-    return c_squared * (L * x);
-}
-
 int main() {
     // Parameters
     constexpr int kAccuracyOrder = 2;     // Order of accuracy (spatial)
@@ -34,6 +29,9 @@ int main() {
     // Create Laplacian operator
     Laplacian L(kAccuracyOrder, kNumCells, kDx);
 
+    // Position Verlet with the allocation-free force c^2 * L * u
+    Verlet verlet(Verlet::POSITION, Integrator::linear(kWaveSpeedSquared * L));
+
     // Initial conditions
     arma::vec u = arma::sin(M_PI * xgrid);
     arma::vec v = arma::zeros<arma::vec>(kNumCells+2);
@@ -49,10 +47,7 @@ int main() {
 
     // Time integration loop
     for (int step = 0; step <= kNumSteps; step++) {
-        // Position Verlet algorithm
-        u += 0.5 * kDt * v;
-        v += kDt * calculateForce(L, u, kWaveSpeedSquared);
-        u += 0.5 * kDt * v;
+        verlet.step(step * kDt, kDt, u, v);
 
         // Save solution at regular intervals
         if (step % kSaveInterval == 0) {
@@ -0,0 +1,224 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file adaptiveintegrator.cpp
+ *
+ * @brief Embedded Runge-Kutta integrators with step size control
+ *
+ * @date 2026/10/19
+ */
+
+#include "adaptiveintegrator.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+// Butcher tableau of an embedded pair whose last stage is evaluated at the
+// new solution (FSAL), so the last row of a holds the weights b
+struct Tableau {
+  u32 stages;
+  u32 order;     // Order of the error estimate + 1, for the controller
+  Real c[7];
+  Real a[7][7];
+  Real e[7];     // b - bhat
+};
+
+const Tableau bogacki_shampine = {
+    4,
+    3,
+    {0, 1.0 / 2, 3.0 / 4, 1},
+    {{0},
+     {1.0 / 2},
+     {0, 3.0 / 4},
+     {2.0 / 9, 1.0 / 3, 4.0 / 9}},
+    {-5.0 / 72, 1.0 / 12, 1.0 / 9, -1.0 / 8}};
+
+const Tableau dormand_prince = {
+    7,
+    5,
+    {0, 1.0 / 5, 3.0 / 10, 4.0 / 5, 8.0 / 9, 1, 1},
+    {{0},
+     {1.0 / 5},
+     {3.0 / 40, 9.0 / 40},
+     {44.0 / 45, -56.0 / 15, 32.0 / 9},
+     {19372.0 / 6561, -25360.0 / 2187, 64448.0 / 6561, -212.0 / 729},
+     {9017.0 / 3168, -355.0 / 33, 46732.0 / 5247, 49.0 / 176,
+      -5103.0 / 18656},
+     {35.0 / 384, 0, 500.0 / 1113, 125.0 / 192, -2187.0 / 6784, 11.0 / 84}},
+    {71.0 / 57600, 0, -71.0 / 16695, 71.0 / 1920, -17253.0 / 339200,
+     22.0 / 525, -1.0 / 40}};
+
+// y = x + dt * sum_j coef[j] k[j], j < n, in a single pass
+void combine(vec &y, const vec *x, Real dt, const Real *coef,
+             const std::vector<vec> &k, u32 n) {
+  const Real *pk[7];
+  for (u32 j = 0; j < n; ++j)
+    pk[j] = k[j].memptr();
+
+  Real *py = y.memptr();
+  const Real *px = x ? x->memptr() : nullptr;
+  const uword N = y.n_elem;
+
+  for (uword i = 0; i < N; ++i) {
+    Real sum = 0;
+    for (u32 j = 0; j < n; ++j)
+      sum += coef[j] * pk[j][i];
+    py[i] = (px ? px[i] : 0) + dt * sum;
+  }
+}
+
+} // namespace
+
+AdaptiveIntegrator::AdaptiveIntegrator(Method method, const Integrator::RHS &f,
+                                       Real rtol, Real atol)
+    : method(method), f(f), rtol(rtol), atol(atol) {
+  if (rtol <= 0 && atol <= 0)
+    throw std::invalid_argument("AdaptiveIntegrator: tolerances must be > 0");
+}
+
+void AdaptiveIntegrator::resize(uword N) {
+  const Tableau &tab =
+      method == DORMAND_PRINCE ? dormand_prince : bogacki_shampine;
+
+  if (k.size() == tab.stages && w.n_elem == N)
+    return;
+
+  k.assign(tab.stages, vec(N));
+  w.set_size(N);
+  e.set_size(N);
+  fsal = false;
+}
+
+Real AdaptiveIntegrator::weighted_norm(const vec &v, const vec &u,
+                                       const vec &w) const {
+  Real sum = 0;
+  for (uword i = 0; i < v.n_elem; ++i) {
+    Real scale = atol + rtol * std::max(std::abs(u(i)), std::abs(w(i)));
+    sum += (v(i) / scale) * (v(i) / scale);
+  }
+
+  return std::sqrt(sum / std::max<uword>(v.n_elem, 1));
+}
+
+Real AdaptiveIntegrator::initial_dt(Real t, Real tf, const vec &u) {
+  const Tableau &tab =
+      method == DORMAND_PRINCE ? dormand_prince : bogacki_shampine;
+
+  f(t, u, k[0]);
+  ++info.evaluations;
+  fsal = true;
+
+  Real d0 = weighted_norm(u, u, u);
+  Real d1 = weighted_norm(k[0], u, u);
+  Real h0 = (d0 < 1e-5 || d1 < 1e-5) ? 1e-6 : 0.01 * d0 / d1;
+  h0 = std::min(h0, tf - t);
+
+  // One explicit Euler step estimates the second derivative
+  w = u + h0 * k[0];
+  f(t + h0, w, k[1]);
+  ++info.evaluations;
+  e = k[1] - k[0];
+  Real d2 = weighted_norm(e, u, u) / h0;
+
+  Real dmax = std::max(d1, d2);
+  Real h1 = dmax <= 1e-15 ? std::max(1e-6, 1e-3 * h0)
+                          : std::pow(0.01 / dmax, 1.0 / tab.order);
+
+  return std::min({100 * h0, h1, tf - t});
+}
+
+bool AdaptiveIntegrator::step(Real &t, Real &dt, vec &u) {
+  const Tableau &tab =
+      method == DORMAND_PRINCE ? dormand_prince : bogacki_shampine;
+  const u32 s = tab.stages;
+
+  resize(u.n_elem);
+
+  if (max_dt > 0)
+    dt = std::min(dt, max_dt);
+
+  if (!fsal) {
+    f(t, u, k[0]);
+    ++info.evaluations;
+    fsal = true;
+  }
+
+  // The last stage argument is the new solution
+  for (u32 i = 1; i < s; ++i) {
+    combine(w, &u, dt, tab.a[i], k, i);
+    f(t + tab.c[i] * dt, w, k[i]);
+    ++info.evaluations;
+  }
+
+  combine(e, nullptr, dt, tab.e, k, s);
+  Real err = weighted_norm(e, u, w);
+
+  const Real safety = 0.9, fac_min = 0.2, fac_max = 5;
+  const Real p = tab.order;
+
+  if (err > 1 || !std::isfinite(err)) {
+    ++info.rejected;
+    rejected = true;
+
+    Real fac = std::isfinite(err) ? safety * std::pow(err, -1 / p) : fac_min;
+    dt *= std::max(fac_min, fac);
+
+    if (dt < 1e-14 * std::max(std::abs(t), 1.0))
+      throw std::runtime_error("AdaptiveIntegrator: step size underflow");
+
+    return false;
+  }
+
+  // PI controller, no growth right after a rejection
+  Real fac = err == 0 ? fac_max
+                      : safety * std::pow(err, -0.7 / p) *
+                            std::pow(previous_err, 0.4 / p);
+  fac = std::min(std::max(fac, fac_min), rejected ? 1.0 : fac_max);
+
+  previous_err = std::max(err, 1e-4);
+  rejected = false;
+
+  ++info.accepted;
+  info.dt_min = info.accepted == 1 ? dt : std::min(info.dt_min, dt);
+  info.dt_max = std::max(info.dt_max, dt);
+
+  t += dt;
+  u = w;
+  k[0].swap(k[s - 1]);
+
+  dt *= fac;
+  return true;
+}
+
+AdaptiveStats AdaptiveIntegrator::integrate(Real t0, Real tf, vec &u,
+                                            Real dt) {
+  info = AdaptiveStats();
+  previous_err = 1e-4;
+  rejected = false;
+  fsal = false;
+  resize(u.n_elem);
+
+  if (dt <= 0)
+    dt = initial_dt(t0, tf, u);
+
+  Real t = t0;
+  while (tf - t > 1e-12 * std::max(std::abs(tf), 1.0)) {
+    if (max_dt > 0)
+      dt = std::min(dt, max_dt);
+
+    // Stretch the step a little rather than leave a sliver at the end
+    bool last = t + 1.01 * dt >= tf;
+    Real h = last ? tf - t : dt;
+
+    if (step(t, h, u) && last)
+      t = tf;
+    dt = h;
+  }
+
+  return info;
+}
@@ -0,0 +1,124 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file adaptiveintegrator.h
+ *
+ * @brief Embedded Runge-Kutta integrators with step size control
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef ADAPTIVEINTEGRATOR_H
+#define ADAPTIVEINTEGRATOR_H
+
+#include "integrator.h"
+
+/**
+ * @brief Work of an adaptive integration
+ *
+ */
+struct AdaptiveStats {
+  u32 accepted = 0;    ///< Accepted steps
+  u32 rejected = 0;    ///< Rejected steps
+  u32 evaluations = 0; ///< Evaluations of the right hand side
+  Real dt_min = 0;     ///< Smallest accepted step
+  Real dt_max = 0;     ///< Largest accepted step
+};
+
+/**
+ * @brief Embedded Runge-Kutta pairs with PI step size control for
+ * du/dt = f(t, u)
+ *
+ * Each step computes a solution and an error estimate from the same stages.
+ * The estimate is measured in the norm
+ *
+ *   err = sqrt(mean((e_i / (atol + rtol * max(|u_i|, |u+_i|)))^2))
+ *
+ * and the step is accepted if err <= 1. The next step comes from a PI
+ * controller, which avoids the oscillating step sizes of the classical
+ * controller when the step is limited by stability rather than accuracy.
+ * Both pairs propagate the higher order solution and reuse the last stage
+ * as the first one of the next step (FSAL). Stage buffers are allocated on
+ * the first step only.
+ */
+class AdaptiveIntegrator {
+public:
+  /**
+   * @brief Available pairs
+   */
+  enum Method {
+    BOGACKI_SHAMPINE, ///< Order 3(2), 4 stages, for loose tolerances
+    DORMAND_PRINCE    ///< Order 5(4), 7 stages
+  };
+
+  /**
+   * @brief AdaptiveIntegrator constructor
+   *
+   * @param method embedded pair
+   * @param f right hand side, e.g. Integrator::linear(L)
+   * @param rtol relative tolerance
+   * @param atol absolute tolerance
+   */
+  AdaptiveIntegrator(Method method, const Integrator::RHS &f, Real rtol = 1e-6,
+                     Real atol = 1e-9);
+
+  /**
+   * @brief Advances u in place from t0 to tf
+   *
+   * @param dt initial step, estimated from f if zero
+   */
+  AdaptiveStats integrate(Real t0, Real tf, vec &u, Real dt = 0);
+
+  /**
+   * @brief Attempts one step of size dt
+   *
+   * On acceptance u and t are advanced. In both cases dt is replaced by the
+   * proposed size of the next step.
+   *
+   * @return true if the step was accepted
+   */
+  bool step(Real &t, Real &dt, vec &u);
+
+  /**
+   * @brief Discards the reused last stage, needed if u is changed between
+   * calls to step()
+   */
+  void reset() { fsal = false; }
+
+  /**
+   * @brief Limits the step size, e.g. to resolve a forcing, unlimited if zero
+   */
+  void set_max_dt(Real dt) { max_dt = dt; }
+
+  /**
+   * @brief Work since construction or the last integrate()
+   */
+  const AdaptiveStats &stats() const { return info; }
+
+private:
+  // Sizes the stage buffers, only allocates the first time
+  void resize(uword N);
+
+  // Initial step from the size of f and of its change (Hairer & Wanner)
+  Real initial_dt(Real t, Real tf, const vec &u);
+
+  // Error-weighted RMS norm of v
+  Real weighted_norm(const vec &v, const vec &u, const vec &w) const;
+
+  Method method;
+  Integrator::RHS f;
+  Real rtol, atol;
+  Real max_dt = 0;
+  Real previous_err = 1e-4; // Error of the last accepted step, for PI
+  bool fsal = false;        // True if k[0] holds f at the current u
+  bool rejected = false;    // True if the last attempt was rejected
+  AdaptiveStats info;
+  std::vector<vec> k;       // Stages
+  vec w, e;                 // Stage argument or new solution, error estimate
+};
+
+#endif // ADAPTIVEINTEGRATOR_H
@@ -0,0 +1,491 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file amr.cpp
+ *
+ * @brief Block-structured adaptive mesh refinement in 2-D
+ *
+ * @date 2026/10/19
+ */
+
+#include "amr.h"
+#include "divergence.h"
+#include "gradient.h"
+#include "interpol.h"
+#include "laplacian.h"
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+namespace {
+
+// Linear interpolation at s of values v(c) at the increasing ticks t(c)
+Real linear(const vec &t, const rowvec &v, Real s) {
+  uword c = std::upper_bound(t.begin(), t.end(), s) - t.begin();
+  c = std::min<uword>(std::max<uword>(c, 1), t.n_elem - 1);
+  Real w = (s - t(c - 1)) / (t(c) - t(c - 1));
+  return (1 - w) * v(c - 1) + w * v(c);
+}
+
+// Sides of a cell, opposite sides differ in the last bit
+enum Side { WEST, EAST, SOUTH, NORTH };
+
+// Index in the face vector of Gradient(k, m, n, dx, dy) of one side of cell
+// (i, j), 0 <= i < m and 0 <= j < n
+uword face(u32 m, u32 n, int side, u32 i, u32 j) {
+  switch (side) {
+  case WEST:
+    return i + uword(m + 1) * j;
+  case EAST:
+    return i + 1 + uword(m + 1) * j;
+  case SOUTH:
+    return uword(m + 1) * n + i + uword(m) * j;
+  default:
+    return uword(m + 1) * n + i + uword(m) * (j + 1);
+  }
+}
+
+// A face on the boundary of a patch of a level with M x N cells
+struct Face {
+  int side;     // Side of the inner cell the face is on
+  u32 i, j;     // Inner cell, 0-based in the patch
+  u32 oi, oj;   // Outer cell, in the index space of the level
+  uword flux;   // Index in the face vector of the patch
+  Real h, sign; // Cell width across the face, -1 on west and south faces
+};
+
+// Faces of the boundary of patch P that are not on the domain boundary
+std::vector<Face> boundary(const Patch &P, u32 M, u32 N) {
+  const u32 pm = P.grid.m, pn = P.grid.n;
+  std::vector<Face> faces;
+
+  for (int side = WEST; side <= NORTH; ++side) {
+    const bool x = side < SOUTH;
+    const int di = side == WEST ? -1 : side == EAST ? 1 : 0;
+    const int dj = side == SOUTH ? -1 : side == NORTH ? 1 : 0;
+
+    for (u32 t = 0; t < (x ? pn : pm); ++t) {
+      Face f;
+      f.side = side;
+      f.i = x ? (side == WEST ? 0 : pm - 1) : t;
+      f.j = x ? t : (side == SOUTH ? 0 : pn - 1);
+
+      const long oi = long(P.i0 + f.i) + di, oj = long(P.j0 + f.j) + dj;
+      if (oi < 0 || oj < 0 || oi >= long(M) || oj >= long(N))
+        continue;
+      f.oi = oi;
+      f.oj = oj;
+
+      f.flux = face(pm, pn, side, f.i, f.j);
+      f.h = x ? P.grid.dx : P.grid.dy;
+      f.sign = di + dj;
+      faces.push_back(f);
+    }
+  }
+
+  return faces;
+}
+
+} // namespace
+
+AMR::AMR(u16 k, u32 m, u32 n, Real west, Real east, Real south, Real north,
+         u16 max_level)
+    : k(k), max_level(max_level), m(m), n(n), west(west), east(east),
+      south(south), north(north) {
+  if (m < 2 * k + 1 || n < 2 * k + 1)
+    throw std::invalid_argument("AMR: the base level needs 2k + 1 cells");
+
+  levels.push_back({Patch(0, 0, 0, -1, Grid2D(m, n, west, east, south, north))});
+}
+
+uword AMR::n_cells() const {
+  uword cells = 0;
+  for (const auto &patches : levels)
+    for (const Patch &p : patches)
+      cells += p.grid.m * p.grid.n;
+  return cells;
+}
+
+void AMR::regrid(const Criterion &flag) {
+  average_down();
+
+  for (u16 l = 0; l < max_level && l < levels.size(); ++l) {
+    std::vector<Patch> fine;
+
+    for (size_t p = 0; p < levels[l].size(); ++p) {
+      Patch &P = levels[l][p];
+      const u32 pm = P.grid.m, pn = P.grid.n;
+
+      // Flags grown by the buffer
+      umat flags(pm, pn, fill::zeros);
+      for (u32 j = 0; j < pn; ++j)
+        for (u32 i = 0; i < pm; ++i) {
+          if (!flag(P, i + 1, j + 1))
+            continue;
+          u32 ilo = i > buffer ? i - buffer : 0, ihi = std::min(i + buffer, pm - 1);
+          u32 jlo = j > buffer ? j - buffer : 0, jhi = std::min(j + buffer, pn - 1);
+          flags.submat(ilo, jlo, ihi, jhi).ones();
+        }
+
+      std::vector<Box> boxes;
+      cluster(flags, {0, 0, pm, pn}, boxes);
+      fit(boxes, pm, pn);
+
+      for (const Box &b : boxes) {
+        fine.push_back(refine(l, p, b));
+        prolong(fine.back(), P);
+      }
+    }
+
+    // Keep the values of the patches being replaced
+    if (l + 1 < levels.size()) {
+      for (Patch &N : fine) {
+        Field U = N.grid.centers(N.u);
+        for (Patch &O : levels[l + 1]) {
+          Field V = O.grid.centers(O.u);
+          u32 ilo = std::max(N.i0, O.i0), ihi = std::min(N.i0 + N.grid.m, O.i0 + O.grid.m);
+          u32 jlo = std::max(N.j0, O.j0), jhi = std::min(N.j0 + N.grid.n, O.j0 + O.grid.n);
+          for (u32 j = jlo; j < jhi; ++j)
+            for (u32 i = ilo; i < ihi; ++i)
+              U(i - N.i0 + 1, j - N.j0 + 1) = V(i - O.i0 + 1, j - O.j0 + 1);
+        }
+      }
+    }
+
+    if (fine.empty()) {
+      levels.erase(levels.begin() + l + 1, levels.end());
+      break;
+    }
+
+    if (l + 1 < levels.size())
+      levels[l + 1] = std::move(fine);
+    else
+      levels.push_back(std::move(fine));
+    fill(l + 1);
+  }
+}
+
+void AMR::fill(u16 l) {
+  assert(l > 0 && l < levels.size());
+
+  // Parent values on the parent faces, computed once per parent
+  std::map<int, std::pair<mat, mat>> faces;
+
+  for (Patch &P : levels[l]) {
+    Patch &Q = levels[l - 1][P.parent];
+    const u32 qm = Q.grid.m, qn = Q.grid.n, pm = P.grid.m, pn = P.grid.n;
+
+    auto it = faces.find(P.parent);
+    if (it == faces.end()) {
+      const mat U = Q.grid.centers(Q.u).as_mat();
+      sp_mat Ix = Interpol(qm, 0.5), Iy = Interpol(qn, 0.5);
+      mat Fx = Ix * U;            // x-face i, y-node j
+      mat Fy = Iy * mat(U.t());   // y-face j, x-node i
+      it = faces.emplace(P.parent, std::make_pair(Fx, Fy)).first;
+    }
+    const mat &Fx = it->second.first, &Fy = it->second.second;
+
+    const vec xq = Q.grid.xc(), yq = Q.grid.yc();
+    const vec xp = P.grid.xc(), yp = P.grid.yc();
+    const u32 a = P.i0 / 2 - Q.i0, b = P.j0 / 2 - Q.j0;
+
+    const rowvec fw = Fx.row(a), fe = Fx.row(a + pm / 2);
+    const rowvec fs = Fy.row(b), fn = Fy.row(b + pn / 2);
+
+    Field U = P.grid.centers(P.u);
+    for (u32 j = 0; j <= pn + 1; ++j) {
+      U(0, j) = linear(yq, fw, yp(j));
+      U(pm + 1, j) = linear(yq, fe, yp(j));
+    }
+    for (u32 i = 1; i <= pm; ++i) {
+      U(i, 0) = linear(xq, fs, xp(i));
+      U(i, pn + 1) = linear(xq, fn, xp(i));
+    }
+  }
+
+  // Faces shared with a patch of the same level, only interior cells are
+  // read so the order of the patches does not matter
+  const imat owner = owners(l);
+  for (Patch &P : levels[l]) {
+    Field U = P.grid.centers(P.u);
+    for (const Face &f : boundary(P, owner.n_rows, owner.n_cols)) {
+      const sword s = owner(f.oi, f.oj);
+      if (s < 0)
+        continue;
+
+      Patch &S = levels[l][s];
+      Field V = S.grid.centers(S.u);
+      const int di = f.side == WEST ? -1 : f.side == EAST ? 1 : 0;
+      const int dj = f.side == SOUTH ? -1 : f.side == NORTH ? 1 : 0;
+      U(f.i + 1 + di, f.j + 1 + dj) =
+          0.5 * (U(f.i + 1, f.j + 1) + V(f.oi - S.i0 + 1, f.oj - S.j0 + 1));
+    }
+  }
+}
+
+void AMR::average_down() {
+  for (size_t l = levels.size(); l-- > 1;) {
+    for (Patch &P : levels[l]) {
+      Patch &Q = levels[l - 1][P.parent];
+      Field U = P.grid.centers(P.u), V = Q.grid.centers(Q.u);
+      const u32 a = P.i0 / 2 - Q.i0, b = P.j0 / 2 - Q.j0;
+
+      for (u32 j = 0; j < P.grid.n / 2; ++j)
+        for (u32 i = 0; i < P.grid.m / 2; ++i)
+          V(a + i + 1, b + j + 1) =
+              0.25 * (U(2 * i + 1, 2 * j + 1) + U(2 * i + 2, 2 * j + 1) +
+                      U(2 * i + 1, 2 * j + 2) + U(2 * i + 2, 2 * j + 2));
+    }
+  }
+}
+
+const sp_mat &AMR::laplacian(const Patch &p) { return op(LAPLACIAN, p); }
+
+const sp_mat &AMR::gradient(const Patch &p) { return op(GRADIENT, p); }
+
+const sp_mat &AMR::divergence(const Patch &p) { return op(DIVERGENCE, p); }
+
+const sp_mat &AMR::op(Kind kind, const Patch &p) {
+  const std::array<u32, 4> key = {(u32)kind, p.level, p.grid.m, p.grid.n};
+  auto it = operators.find(key);
+  if (it != operators.end())
+    return it->second;
+
+  const u32 pm = p.grid.m, pn = p.grid.n;
+  const Real dx = p.grid.dx, dy = p.grid.dy;
+  sp_mat A;
+  switch (kind) {
+  case LAPLACIAN:
+    A = Laplacian(k, pm, pn, dx, dy);
+    break;
+  case GRADIENT:
+    A = Gradient(k, pm, pn, dx, dy);
+    break;
+  case DIVERGENCE:
+    A = Divergence(k, pm, pn, dx, dy);
+    break;
+  }
+
+  return operators.emplace(key, std::move(A)).first->second;
+}
+
+imat AMR::owners(u16 l) const {
+  imat owner(uword(m) << l, uword(n) << l);
+  owner.fill(-1);
+
+  for (size_t p = 0; p < levels[l].size(); ++p) {
+    const Patch &P = levels[l][p];
+    owner.submat(P.i0, P.j0, P.i0 + P.grid.m - 1, P.j0 + P.grid.n - 1)
+        .fill(p);
+  }
+
+  return owner;
+}
+
+void AMR::diffuse(Real kappa, Real dt) {
+  for (u16 l = 1; l < levels.size(); ++l)
+    fill(l);
+
+  // Boundary rows of the divergence are empty, boundary nodes are kept
+  std::vector<std::vector<vec>> flux(levels.size());
+  for (u16 l = 0; l < levels.size(); ++l)
+    for (Patch &p : levels[l]) {
+      flux[l].push_back(gradient(p) * p.u);
+      p.u += (dt * kappa) * (divergence(p) * flux[l].back());
+    }
+
+  reflux(flux, dt * kappa);
+  average_down();
+}
+
+void AMR::reflux(std::vector<std::vector<vec>> &flux, Real a) {
+  std::vector<imat> owner(levels.size());
+  for (u16 l = 0; l < levels.size(); ++l)
+    owner[l] = owners(l);
+
+  for (size_t l = levels.size(); l-- > 1;) {
+    std::vector<Patch> &patches = levels[l];
+    const imat &own = owner[l];
+
+    // Cells covered by the level above are overwritten by average_down(),
+    // the fluxes of their faces are those of the finer level
+    auto covered = [&](const Patch &P, u32 i, u32 j) {
+      return l + 1 < levels.size() &&
+             owner[l + 1](2 * (P.i0 + i), 2 * (P.j0 + j)) >= 0;
+    };
+
+    // Faces shared by two patches of the level, once each
+    for (size_t p = 0; p < patches.size(); ++p) {
+      Patch &P = patches[p];
+      Field U = P.grid.centers(P.u);
+
+      for (const Face &f : boundary(P, own.n_rows, own.n_cols)) {
+        const sword s = own(f.oi, f.oj);
+        if (s <= sword(p))
+          continue;
+
+        Patch &S = patches[s];
+        Field V = S.grid.centers(S.u);
+        const u32 si = f.oi - S.i0, sj = f.oj - S.j0;
+        Real &fp = flux[l][p](f.flux);
+        Real &fs = flux[l][s](face(S.grid.m, S.grid.n, f.side ^ 1, si, sj));
+
+        const bool cp = covered(P, f.i, f.j), cs = covered(S, si, sj);
+        const Real F = cp == cs ? 0.5 * (fp + fs) : cp ? fp : fs;
+
+        U(f.i + 1, f.j + 1) += a * f.sign * (F - fp) / f.h;
+        V(si + 1, sj + 1) -= a * f.sign * (F - fs) / f.h;
+        fp = fs = F;
+      }
+    }
+
+    // Coarse-fine interfaces, the coarse face is covered by two fine faces
+    for (size_t p = 0; p < patches.size(); ++p) {
+      Patch &P = patches[p];
+      Patch &Q = levels[l - 1][P.parent];
+      Field V = Q.grid.centers(Q.u);
+      vec &FQ = flux[l - 1][P.parent];
+
+      for (const Face &f : boundary(P, own.n_rows, own.n_cols)) {
+        if (own(f.oi, f.oj) >= 0)
+          continue;
+
+        const Real F = flux[l][p](f.flux);
+        const u32 ci = f.oi / 2, cj = f.oj / 2;
+        const u32 qi = (P.i0 + f.i) / 2 - Q.i0, qj = (P.j0 + f.j) / 2 - Q.j0;
+        const uword g = face(Q.grid.m, Q.grid.n, f.side, qi, qj);
+
+        if (ci >= Q.i0 && ci < Q.i0 + Q.grid.m && cj >= Q.j0 &&
+            cj < Q.j0 + Q.grid.n) {
+          // The cell outside is in the parent
+          V(ci - Q.i0 + 1, cj - Q.j0 + 1) -= a * f.sign * 0.5 * (F - FQ(g)) /
+                                              (2 * f.h);
+        } else {
+          // A face of the parent boundary, refluxed with the parent
+          const u32 t = f.side < SOUTH ? P.j0 + f.j : P.i0 + f.i;
+          FQ(g) = (t % 2 ? FQ(g) : 0) + 0.5 * F;
+        }
+      }
+    }
+  }
+}
+
+void AMR::cluster(const umat &flags, Box b, std::vector<Box> &boxes) const {
+  // Shrink to the flagged cells
+  u32 ilo = b.i0 + b.m, ihi = b.i0, jlo = b.j0 + b.n, jhi = b.j0;
+  uword count = 0;
+  for (u32 j = b.j0; j < b.j0 + b.n; ++j)
+    for (u32 i = b.i0; i < b.i0 + b.m; ++i)
+      if (flags(i, j)) {
+        ilo = std::min(ilo, i);
+        ihi = std::max(ihi, i + 1);
+        jlo = std::min(jlo, j);
+        jhi = std::max(jhi, j + 1);
+        ++count;
+      }
+  if (!count)
+    return;
+  b = {ilo, jlo, ihi - ilo, jhi - jlo};
+
+  const u32 min = k + 1;
+  if (count >= efficiency * b.m * b.n || (b.m <= min && b.n <= min)) {
+    boxes.push_back(b);
+    return;
+  }
+
+  // Split the longer side at the hole nearest its middle, or at the middle
+  const bool x = b.m >= b.n;
+  const u32 len = x ? b.m : b.n;
+  std::vector<uword> signature(len, 0);
+  for (u32 j = 0; j < b.n; ++j)
+    for (u32 i = 0; i < b.m; ++i)
+      signature[x ? i : j] += flags(b.i0 + i, b.j0 + j);
+
+  u32 cut = len / 2, hole = len;
+  for (u32 s = 1; s + 1 < len; ++s)
+    if (!signature[s] && (hole == len || std::abs(int(s) - int(len / 2)) <
+                                             std::abs(int(hole) - int(len / 2))))
+      hole = s;
+  if (hole < len)
+    cut = hole;
+
+  Box lo = b, hi = b;
+  if (x) {
+    lo.m = cut;
+    hi.i0 += cut;
+    hi.m -= cut;
+  } else {
+    lo.n = cut;
+    hi.j0 += cut;
+    hi.n -= cut;
+  }
+  cluster(flags, lo, boxes);
+  cluster(flags, hi, boxes);
+}
+
+void AMR::fit(std::vector<Box> &boxes, u32 pm, u32 pn) const {
+  const u32 min = k + 1;
+  auto grow = [](u32 &start, u32 &size, u32 min, u32 total) {
+    if (size >= min)
+      return;
+    u32 lo = start > (min - size) / 2 ? start - (min - size) / 2 : 0;
+    start = std::min(lo, total - std::min(min, total));
+    size = std::min(min, total);
+  };
+
+  for (Box &b : boxes) {
+    grow(b.i0, b.m, min, pm);
+    grow(b.j0, b.n, min, pn);
+  }
+
+  // Merge overlapping boxes into their bounding box until none overlap
+  bool merged = true;
+  while (merged) {
+    merged = false;
+    for (size_t a = 0; a < boxes.size() && !merged; ++a)
+      for (size_t c = a + 1; c < boxes.size() && !merged; ++c) {
+        Box &A = boxes[a], &C = boxes[c];
+        if (A.i0 >= C.i0 + C.m || C.i0 >= A.i0 + A.m || A.j0 >= C.j0 + C.n ||
+            C.j0 >= A.j0 + A.n)
+          continue;
+        u32 i1 = std::max(A.i0 + A.m, C.i0 + C.m), j1 = std::max(A.j0 + A.n, C.j0 + C.n);
+        A.i0 = std::min(A.i0, C.i0);
+        A.j0 = std::min(A.j0, C.j0);
+        A.m = i1 - A.i0;
+        A.n = j1 - A.j0;
+        boxes.erase(boxes.begin() + c);
+        merged = true;
+      }
+  }
+}
+
+Patch AMR::refine(u16 l, size_t p, const Box &b) const {
+  const Patch &P = levels[l][p];
+  const Real dx = P.grid.dx / 2, dy = P.grid.dy / 2;
+  const u32 i0 = 2 * (P.i0 + b.i0), j0 = 2 * (P.j0 + b.j0);
+
+  Real w = west + i0 * dx, s = south + j0 * dy;
+  return Patch(l + 1, i0, j0, p,
+               Grid2D(2 * b.m, 2 * b.n, w, w + 2 * b.m * dx, s, s + 2 * b.n * dy));
+}
+
+void AMR::prolong(Patch &fine, Patch &coarse) const {
+  Field U = fine.grid.centers(fine.u), V = coarse.grid.centers(coarse.u);
+  const vec xq = coarse.grid.xc(), yq = coarse.grid.yc();
+  const vec xp = fine.grid.xc(), yp = fine.grid.yc();
+
+  for (u32 j = 1; j <= fine.grid.n; ++j)
+    for (u32 i = 1; i <= fine.grid.m; ++i) {
+      // Parent cell, as a node of the parent grid
+      u32 a = (fine.i0 + i - 1) / 2 - coarse.i0 + 1;
+      u32 b = (fine.j0 + j - 1) / 2 - coarse.j0 + 1;
+
+      Real sx = (V(a + 1, b) - V(a - 1, b)) / (xq(a + 1) - xq(a - 1));
+      Real sy = (V(a, b + 1) - V(a, b - 1)) / (yq(b + 1) - yq(b - 1));
+      U(i, j) = V(a, b) + sx * (xp(i) - xq(a)) + sy * (yp(j) - yq(b));
+    }
+}
@@ -0,0 +1,201 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file amr.h
+ *
+ * @brief Block-structured adaptive mesh refinement in 2-D
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef AMR_H
+#define AMR_H
+
+#include "grid.h"
+#include "utils.h"
+#include <array>
+#include <functional>
+#include <map>
+#include <vector>
+
+/**
+ * @brief A rectangular patch of cells on one refinement level
+ *
+ * Cell (i, j) of the patch is cell (i0 + i, j0 + j) of its level, whose
+ * cells are half the size of those of the level below. The values u live
+ * on the centers and boundary nodes of the patch grid, as for Laplacian.
+ */
+struct Patch {
+  Patch(u16 level, u32 i0, u32 j0, int parent, const Grid2D &grid)
+      : level(level), i0(i0), j0(j0), parent(parent), grid(grid),
+        u(grid.n_centers(), fill::zeros) {}
+
+  u16 level;      ///< Refinement level, 0 is the base grid
+  u32 i0, j0;     ///< First cell in the index space of the level
+  int parent;     ///< Index of the covering patch one level down, -1 on 0
+  Grid2D grid;    ///< Grid of the patch
+  vec u;          ///< Values at the centers and boundary nodes
+};
+
+/**
+ * @brief Hierarchy of nested patches over a rectangle, refined by two per
+ * level
+ *
+ * Level 0 is a single patch over the domain whose boundary nodes hold the
+ * boundary values. Every patch on level l + 1 lies inside one patch on
+ * level l, its parent, and is aligned with its cells. The levels are
+ * coupled through their parents only:
+ *
+ * - fill() sets the boundary nodes of a patch from its parent, which are
+ *   on parent faces: the parent values are taken to its faces with
+ *   Interpol and then interpolated linearly along the face. Nodes on a
+ *   face shared with a patch of the same level take the mean of the two
+ *   cells next to it instead.
+ * - new patches are prolonged from their parents with linear
+ *   reconstructions whose averages over each parent cell are the parent
+ *   values, and average_down() replaces covered parent cells by the
+ *   averages of their four children, so both directions conserve the
+ *   integral of u.
+ *
+ * regrid() flags cells with a user criterion, grows the flags by a buffer
+ * and clusters them into boxes (Berger-Rigoutsos). The boxes become the
+ * patches of the next level, at least k + 1 parent cells wide so that the
+ * mimetic operators of order k fit.
+ *
+ * diffuse() keeps the face fluxes G*u of every patch as flux registers.
+ * Where patches of one level touch, both take the mean of their fluxes on
+ * the shared faces, and at a coarse-fine interface the coarse cell outside
+ * the patch takes the average of the fine fluxes instead of its own
+ * (refluxing). For k = 2, whose divergence is the difference of the fluxes
+ * on the two faces of a cell, the integral of u over the composite grid
+ * then only changes through the domain boundary.
+ *
+ * @note For k > 2 the divergence of a cell reaches further faces than its
+ * own, and the corrections, made on the cells next to the interfaces,
+ * conserve the integral of u up to truncation error only.
+ */
+class AMR {
+public:
+  /**
+   * @brief Flags cell (i, j), 1 <= i <= m and 1 <= j <= n, of a patch
+   */
+  using Criterion = std::function<bool(const Patch &patch, u32 i, u32 j)>;
+
+  /**
+   * @brief AMR Constructor, with the base level only
+   *
+   * @param k Order of accuracy of the operators
+   * @param m Number of cells of the base level in x-direction
+   * @param n Number of cells of the base level in y-direction
+   * @param west, east Bounds in x-direction
+   * @param south, north Bounds in y-direction
+   * @param max_level Finest level regrid() may create
+   */
+  AMR(u16 k, u32 m, u32 n, Real west, Real east, Real south, Real north,
+      u16 max_level = 2);
+
+  /**
+   * @brief Number of levels in use
+   */
+  u16 n_levels() const { return levels.size(); }
+
+  /**
+   * @brief Patches of level l
+   */
+  std::vector<Patch> &level(u16 l) { return levels[l]; }
+  const std::vector<Patch> &level(u16 l) const { return levels[l]; }
+
+  /**
+   * @brief The base level patch
+   */
+  Patch &base() { return levels[0][0]; }
+
+  /**
+   * @brief Number of cells over all patches of all levels
+   */
+  uword n_cells() const;
+
+  /**
+   * @brief Rebuilds the levels above the base from a refinement criterion
+   *
+   * Values are averaged down first, then every new patch is prolonged from
+   * its parent and overwritten where it overlaps a patch of the same level
+   * it replaces.
+   */
+  void regrid(const Criterion &flag);
+
+  /**
+   * @brief Sets the boundary nodes of the patches of level l > 0 from their
+   * parents and from the patches of level l they touch
+   */
+  void fill(u16 l);
+
+  /**
+   * @brief Replaces covered cells by the average of their children, from
+   * the finest level down
+   */
+  void average_down();
+
+  /**
+   * @brief Mimetic operators of a patch, built once per size and level
+   */
+  const sp_mat &laplacian(const Patch &p);
+  const sp_mat &gradient(const Patch &p);
+  const sp_mat &divergence(const Patch &p);
+
+  /**
+   * @brief One explicit Euler step of u_t = kappa * lap(u) on every level
+   *
+   * The boundary nodes of all levels are filled before any is advanced,
+   * every patch is advanced by the divergence of its fluxes G*u, and the
+   * levels are refluxed and averaged down afterwards. dt is limited by the
+   * finest level.
+   */
+  void diffuse(Real kappa, Real dt);
+
+  Real efficiency = 0.7;   ///< Fraction of flagged cells to accept a box
+  u32 buffer = 2;          ///< Cells added around the flagged cells
+
+private:
+  // Cell box in the index space of a patch
+  struct Box {
+    u32 i0, j0, m, n;
+  };
+
+  enum Kind { LAPLACIAN, GRADIENT, DIVERGENCE };
+
+  // Berger-Rigoutsos clustering of the flags inside box b
+  void cluster(const umat &flags, Box b, std::vector<Box> &boxes) const;
+
+  // Grown to the minimum size inside an m x n patch, overlaps merged
+  void fit(std::vector<Box> &boxes, u32 m, u32 n) const;
+
+  // Fine patch over box b of patch p on level l
+  Patch refine(u16 l, size_t p, const Box &b) const;
+
+  // Conservative linear prolongation of the parent values
+  void prolong(Patch &fine, Patch &coarse) const;
+
+  const sp_mat &op(Kind kind, const Patch &p);
+
+  // Index of the patch of level l owning each cell of its index space, -1
+  // where there is none
+  imat owners(u16 l) const;
+
+  // Makes the fluxes of the faces shared by patches of a level agree and
+  // corrects the coarse cells next to the patches of the level above, from
+  // the finest level down. a is dt times the diffusivity.
+  void reflux(std::vector<std::vector<vec>> &flux, Real a);
+
+  u16 k, max_level;
+  u32 m, n;
+  Real west, east, south, north;
+  std::vector<std::vector<Patch>> levels;
+  std::map<std::array<u32, 4>, sp_mat> operators; // By kind, level, m, n
+};
+
+#endif // AMR_H
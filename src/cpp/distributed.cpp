@@ -0,0 +1,549 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file distributed.cpp
+ *
+ * @brief Mimetic operators on a 3-D grid partitioned over MPI ranks
+ *
+ * @date 2026/10/19
+ */
+
+#ifdef MOLE_USE_MPI
+
+#include "distributed.h"
+#include "divergence.h"
+#include "gradient.h"
+#include "interpol.h"
+#include "laplacian.h"
+#include "robinbc.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <stdexcept>
+
+namespace {
+
+// Owned block of the scalars (ghosts along every axis) or of the faces
+// normal to axis d (ghosts along d only)
+Block block(const Partition &p, int d) {
+  const uword g = p.k / 2;
+  Block b;
+
+  for (u16 a = 0; a < 3; ++a) {
+    const uword M = p.cells[a], s = p.first[a], e = s + p.count[a];
+    if (d < 0) {
+      // Nodes s + 1, ..., e, and the boundary nodes of the edge ranks
+      b.start[a] = s == 0 ? 0 : s + 1;
+      b.count[a] = (e == M ? M + 2 : e + 1) - b.start[a];
+      b.global[a] = M + 2;
+    } else if (a == d) {
+      // Faces s, ..., e - 1, and face M on the last rank
+      b.start[a] = s;
+      b.count[a] = e - s + (e == M);
+      b.global[a] = M + 1;
+    } else {
+      b.start[a] = s;
+      b.count[a] = e - s;
+      b.global[a] = M;
+    }
+
+    bool ghosts = d < 0 || a == d;
+    b.lo[a] = ghosts && p.lower[a] != MPI_PROC_NULL ? g : 0;
+    b.hi[a] = ghosts && p.upper[a] != MPI_PROC_NULL ? g : 0;
+    b.dim[a] = b.lo[a] + b.count[a] + b.hi[a];
+  }
+
+  b.size = b.dim[0] * b.dim[1] * b.dim[2];
+  b.offset = 0;
+  b.global_offset = 0;
+  return b;
+}
+
+// Calls f(position in the block, position in the global vector) for every
+// owned entry
+template <typename F> void owned(const Block &b, F f) {
+  for (uword l = b.start[2]; l < b.start[2] + b.count[2]; ++l)
+    for (uword j = b.start[1]; j < b.start[1] + b.count[1]; ++j) {
+      uword p = b.at(b.start[0], j, l);
+      uword q = b.global_offset + b.start[0] +
+                b.global[0] * (j + b.global[1] * l);
+      for (uword i = 0; i < b.count[0]; ++i)
+        f(p + i, q + i);
+    }
+}
+
+// Owned rows and columns of the scalars of sum_d A[d] along axis d, where
+// the terms of axis d skip the boundary nodes of every axis e with
+// skip(d, e), as for the Kronecker products of Laplacian and RobinBC
+template <typename F>
+sp_mat assemble(const Block &b, const std::vector<sp_mat> &A, F skip) {
+  const uword N = b.count[0] * b.count[1] * b.count[2];
+  std::vector<uword> rows, cols;
+  std::vector<Real> values;
+
+  auto local = [&](const uword g[3]) {
+    return (g[0] - b.start[0]) +
+           b.count[0] * ((g[1] - b.start[1]) + b.count[1] * (g[2] - b.start[2]));
+  };
+
+  for (u16 d = 0; d < 3; ++d) {
+    sp_mat At = A[d].t();
+    uword g[3], c[3];
+    for (g[2] = b.start[2]; g[2] < b.start[2] + b.count[2]; ++g[2])
+      for (g[1] = b.start[1]; g[1] < b.start[1] + b.count[1]; ++g[1])
+        for (g[0] = b.start[0]; g[0] < b.start[0] + b.count[0]; ++g[0]) {
+          bool boundary = false;
+          for (u16 e = 0; e < 3; ++e)
+            if (e != d && skip(d, e) && (g[e] == 0 || g[e] + 1 == b.global[e]))
+              boundary = true;
+          if (boundary)
+            continue;
+
+          std::copy(g, g + 3, c);
+          for (auto it = At.begin_col(g[d]); it != At.end_col(g[d]); ++it) {
+            c[d] = it.row();
+            if (c[d] < b.start[d] || c[d] >= b.start[d] + b.count[d])
+              continue;
+            rows.push_back(local(g));
+            cols.push_back(local(c));
+            values.push_back(*it);
+          }
+        }
+  }
+
+  umat locations(2, values.size());
+  for (uword v = 0; v < values.size(); ++v) {
+    locations(0, v) = rows[v];
+    locations(1, v) = cols[v];
+  }
+
+  // Entries of several axes on the same position are summed
+  return sp_mat(true, locations, vec(values), N, N);
+}
+
+} // namespace
+
+Partition::Partition(MPI_Comm comm, u16 k, u32 m, u32 n, u32 o) : k(k) {
+  assert(k % 2 == 0);
+
+  MPI_Comm_size(comm, &size);
+  int periods[3] = {0, 0, 0};
+  dims[0] = dims[1] = dims[2] = 0;
+  MPI_Dims_create(size, 3, dims);
+  MPI_Cart_create(comm, 3, dims, periods, 0, &this->comm);
+  MPI_Comm_rank(this->comm, &rank);
+  MPI_Cart_coords(this->comm, rank, 3, coords);
+
+  cells[0] = m;
+  cells[1] = n;
+  cells[2] = o;
+
+  for (int a = 0; a < 3; ++a) {
+    MPI_Cart_shift(this->comm, a, 1, &lower[a], &upper[a]);
+
+    // The first cells[a] % dims[a] ranks take one more cell
+    u32 q = cells[a] / dims[a], r = cells[a] % dims[a], c = coords[a];
+    if (q < k) {
+      MPI_Comm_free(&this->comm);
+      throw std::invalid_argument("Partition: fewer than k cells per rank");
+    }
+    count[a] = q + (c < r);
+    first[a] = c * q + std::min(c, r);
+  }
+}
+
+Partition::~Partition() {
+  int finalized;
+  MPI_Finalized(&finalized);
+  if (!finalized)
+    MPI_Comm_free(&comm);
+}
+
+// Subarray types of the planes sent to and received from each neighbor
+struct DistributedField::Halo {
+  enum { SEND_LO, RECV_LO, SEND_HI, RECV_HI };
+
+  std::vector<std::array<MPI_Datatype, 4>> types; // By block and axis
+
+  explicit Halo(const std::vector<Block> &blocks) {
+    for (const Block &b : blocks) {
+      for (u16 a = 0; a < 3; ++a) {
+        std::array<MPI_Datatype, 4> t;
+        t.fill(MPI_DATATYPE_NULL);
+
+        int sizes[3], sub[3], starts[3];
+        for (u16 c = 0; c < 3; ++c) {
+          sizes[c] = b.dim[c];
+          sub[c] = b.count[c];
+          starts[c] = b.lo[c];
+        }
+
+        auto make = [&](int side, int planes, int start) {
+          sub[a] = planes;
+          starts[a] = start;
+          MPI_Type_create_subarray(3, sizes, sub, starts, MPI_ORDER_FORTRAN,
+                                   MPI_DOUBLE, &t[side]);
+          MPI_Type_commit(&t[side]);
+        };
+
+        if (b.lo[a]) {
+          make(SEND_LO, b.lo[a], b.lo[a]);
+          make(RECV_LO, b.lo[a], 0);
+        }
+        if (b.hi[a]) {
+          make(SEND_HI, b.hi[a], b.lo[a] + b.count[a] - b.hi[a]);
+          make(RECV_HI, b.hi[a], b.lo[a] + b.count[a]);
+        }
+        types.push_back(t);
+      }
+    }
+  }
+
+  ~Halo() {
+    int finalized;
+    MPI_Finalized(&finalized);
+    if (finalized)
+      return;
+    for (auto &t : types)
+      for (MPI_Datatype &type : t)
+        if (type != MPI_DATATYPE_NULL)
+          MPI_Type_free(&type);
+  }
+};
+
+DistributedField::DistributedField(const Partition &partition, bool faces)
+    : part(&partition) {
+  if (!faces)
+    blocks.push_back(block(partition, -1));
+  else
+    for (int d = 0; d < 3; ++d)
+      blocks.push_back(block(partition, d));
+
+  uword offset = 0, global_offset = 0;
+  for (Block &b : blocks) {
+    b.offset = offset;
+    b.global_offset = global_offset;
+    offset += b.size;
+    global_offset += b.global[0] * b.global[1] * b.global[2];
+  }
+
+  values.zeros(offset);
+  halo = std::make_shared<Halo>(blocks);
+}
+
+void DistributedField::scatter(const vec &global) {
+  const Block &last = blocks.back();
+  assert(global.n_elem == last.global_offset + last.global[0] *
+                                                   last.global[1] *
+                                                   last.global[2]);
+
+  for (const Block &b : blocks)
+    owned(b, [&](uword p, uword q) { values(p) = global(q); });
+}
+
+vec DistributedField::gather() const {
+  const Block &last = blocks.back();
+  vec global(last.global_offset +
+                 last.global[0] * last.global[1] * last.global[2],
+             fill::zeros);
+
+  for (const Block &b : blocks)
+    owned(b, [&](uword p, uword q) { global(q) = values(p); });
+
+  MPI_Allreduce(MPI_IN_PLACE, global.memptr(), global.n_elem, MPI_DOUBLE,
+                MPI_SUM, part->comm);
+  return global;
+}
+
+vec DistributedField::pack() const {
+  vec packed(n_owned());
+  uword v = 0;
+  for (const Block &b : blocks)
+    owned(b, [&](uword p, uword) { packed(v++) = values(p); });
+  return packed;
+}
+
+void DistributedField::unpack(const vec &packed) {
+  assert(packed.n_elem == n_owned());
+  uword v = 0;
+  for (const Block &b : blocks)
+    owned(b, [&](uword p, uword) { values(p) = packed(v++); });
+}
+
+void DistributedField::begin_exchange() {
+  assert(requests.empty());
+
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    Real *base = values.memptr() + blocks[i].offset;
+
+    for (int a = 0; a < 3; ++a) {
+      const auto &t = halo->types[3 * i + a];
+      // Tag of the planes travelling down, plus one for those going up
+      const int tag = 6 * i + 2 * a;
+
+      if (blocks[i].lo[a]) {
+        requests.emplace_back();
+        MPI_Irecv(base, 1, t[Halo::RECV_LO], part->lower[a], tag + 1,
+                  part->comm, &requests.back());
+        requests.emplace_back();
+        MPI_Isend(base, 1, t[Halo::SEND_LO], part->lower[a], tag, part->comm,
+                  &requests.back());
+      }
+      if (blocks[i].hi[a]) {
+        requests.emplace_back();
+        MPI_Irecv(base, 1, t[Halo::RECV_HI], part->upper[a], tag, part->comm,
+                  &requests.back());
+        requests.emplace_back();
+        MPI_Isend(base, 1, t[Halo::SEND_HI], part->upper[a], tag + 1,
+                  part->comm, &requests.back());
+      }
+    }
+  }
+}
+
+void DistributedField::end_exchange() {
+  MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+  requests.clear();
+}
+
+Real DistributedField::dot(const DistributedField &other) const {
+  assert(other.values.n_elem == values.n_elem);
+
+  Real sum = 0;
+  for (const Block &b : blocks)
+    owned(b, [&](uword p, uword) { sum += values(p) * other.values(p); });
+
+  MPI_Allreduce(MPI_IN_PLACE, &sum, 1, MPI_DOUBLE, MPI_SUM, part->comm);
+  return sum;
+}
+
+uword DistributedField::n_owned() const {
+  uword n = 0;
+  for (const Block &b : blocks)
+    n += b.count[0] * b.count[1] * b.count[2];
+  return n;
+}
+
+DistributedOperator::DistributedOperator(const Partition &partition, Kind kind,
+                                         const std::vector<sp_mat> &A)
+    : part(partition), kind(kind) {
+  const bool to_faces = kind == GRADIENT || kind == CENTERS_TO_FACES;
+  const DistributedField x = domain(), y = range();
+
+  for (u16 d = 0; d < 3; ++d) {
+    Term t;
+    t.axis = d;
+    t.in = x.blocks[to_faces ? 0 : d];
+    t.out = y.blocks[to_faces ? d : 0];
+    const Block &in = t.in, &out = t.out;
+
+    for (u16 b = 0; b < 3; ++b) {
+      if (b == d) {
+        t.lo[b] = out.lo[b];
+        t.hi[b] = out.lo[b] + out.count[b];
+        t.shift[b] = 0;
+        continue;
+      }
+
+      // Face j is inside cell j, which is node j + 1, and scalars out of
+      // the faces leave the boundary nodes alone
+      uword first = out.start[b], last = out.start[b] + out.count[b];
+      if (!to_faces) {
+        first = std::max<uword>(first, 1);
+        last = std::min<uword>(last, part.cells[b] + 1);
+      }
+      t.lo[b] = first - out.start[b] + out.lo[b];
+      t.hi[b] = last - out.start[b] + out.lo[b];
+      t.shift[b] = (to_faces ? 1 : -1) - (int)in.start[b] + (int)in.lo[b] +
+                   (int)out.start[b] - (int)out.lo[b];
+    }
+
+    // Owned rows of the 1-D operator, by columns of its transpose
+    sp_mat At = A[d].t();
+    const uword lowest = in.start[d] - in.lo[d];
+    for (uword r = 0; r < out.count[d]; ++r) {
+      const uword row = out.start[d] + r;
+      uword lo = At.n_rows, hi = 0;
+      for (auto it = At.begin_col(row); it != At.end_col(row); ++it) {
+        lo = std::min<uword>(lo, it.row());
+        hi = std::max<uword>(hi, it.row());
+      }
+
+      std::vector<Real> w;
+      if (lo > hi) {
+        lo = hi = in.start[d];
+      } else {
+        assert(lo >= lowest && hi < in.start[d] + in.count[d] + in.hi[d]);
+        w.assign(hi - lo + 1, 0.0);
+        for (auto it = At.begin_col(row); it != At.end_col(row); ++it)
+          w[it.row() - lo] = *it;
+      }
+
+      t.band.first.push_back(lo - lowest);
+      t.band.weights.push_back(w);
+      t.band.inner.push_back(lo >= in.start[d] &&
+                             hi < in.start[d] + in.count[d]);
+    }
+
+    terms.push_back(t);
+  }
+}
+
+DistributedField DistributedOperator::range() const {
+  return DistributedField(part, kind == GRADIENT || kind == CENTERS_TO_FACES);
+}
+
+DistributedField DistributedOperator::domain() const {
+  return DistributedField(part, kind == DIVERGENCE || kind == FACES_TO_CENTERS);
+}
+
+void DistributedOperator::apply(DistributedField &x, DistributedField &y) const {
+  assert(&x.partition() == &part && &y.partition() == &part);
+  assert(x.blocks.size() == (kind == GRADIENT || kind == CENTERS_TO_FACES ? 1u : 3u));
+  assert(y.blocks.size() == (kind == GRADIENT || kind == CENTERS_TO_FACES ? 3u : 1u));
+
+  x.begin_exchange();
+  y.values.zeros();
+  for (const Term &t : terms)
+    apply(t, x.values.memptr(), y.values.memptr(), true);
+
+  x.end_exchange();
+  for (const Term &t : terms)
+    apply(t, x.values.memptr(), y.values.memptr(), false);
+}
+
+void DistributedOperator::apply(const Term &t, const Real *x, Real *y,
+                                bool inner) const {
+  const Block &in = t.in, &out = t.out;
+  const std::ptrdiff_t si[3] = {1, (std::ptrdiff_t)in.dim[0],
+                                (std::ptrdiff_t)(in.dim[0] * in.dim[1])};
+  const std::ptrdiff_t so[3] = {1, (std::ptrdiff_t)out.dim[0],
+                                (std::ptrdiff_t)(out.dim[0] * out.dim[1])};
+  const Real *X = x + in.offset;
+  Real *Y = y + out.offset;
+  const Band &B = t.band;
+  const int nr = B.first.size();
+
+  if (t.axis == 0) {
+    // Rows of the stencil run along the contiguous axis
+    const int nj = t.hi[1] - t.lo[1], nl = t.hi[2] - t.lo[2];
+
+#pragma omp parallel for schedule(static)
+    for (int q = 0; q < nj * nl; ++q) {
+      const std::ptrdiff_t j = t.lo[1] + q % nj, l = t.lo[2] + q / nj;
+      const Real *xr = X + si[1] * (j + t.shift[1]) + si[2] * (l + t.shift[2]);
+      Real *yr = Y + so[1] * j + so[2] * l + t.lo[0];
+
+      for (int r = 0; r < nr; ++r) {
+        if ((bool)B.inner[r] != inner)
+          continue;
+        const std::vector<Real> &w = B.weights[r];
+        const Real *xc = xr + B.first[r];
+        Real sum = 0;
+        for (size_t c = 0; c < w.size(); ++c)
+          sum += w[c] * xc[c];
+        yr[r] += sum;
+      }
+    }
+    return;
+  }
+
+  // A combination of whole lines along x
+  const u16 d = t.axis, e = d == 1 ? 2 : 1;
+  const int ne = t.hi[e] - t.lo[e];
+  const std::ptrdiff_t i0 = t.lo[0], i1 = t.hi[0], s0 = t.shift[0];
+
+#pragma omp parallel for schedule(static)
+  for (int q = 0; q < ne * nr; ++q) {
+    const int r = q % nr;
+    if ((bool)B.inner[r] != inner)
+      continue;
+    const std::ptrdiff_t a = t.lo[e] + q / nr;
+    Real *yl = Y + so[d] * (t.lo[d] + r) + so[e] * a;
+
+    const std::vector<Real> &w = B.weights[r];
+    for (size_t c = 0; c < w.size(); ++c) {
+      const Real *xl = X + si[d] * (B.first[r] + c) + si[e] * (a + t.shift[e]);
+      const Real wc = w[c];
+#pragma omp simd
+      for (std::ptrdiff_t i = i0; i < i1; ++i)
+        yl[i] += wc * xl[i + s0];
+    }
+  }
+}
+
+DistributedGradient::DistributedGradient(const Partition &p, Real dx, Real dy,
+                                         Real dz)
+    : DistributedOperator(p, GRADIENT,
+                          {Gradient(p.k, p.cells[0], dx),
+                           Gradient(p.k, p.cells[1], dy),
+                           Gradient(p.k, p.cells[2], dz)}) {}
+
+DistributedDivergence::DistributedDivergence(const Partition &p, Real dx,
+                                             Real dy, Real dz)
+    : DistributedOperator(p, DIVERGENCE,
+                          {Divergence(p.k, p.cells[0], dx),
+                           Divergence(p.k, p.cells[1], dy),
+                           Divergence(p.k, p.cells[2], dz)}) {}
+
+DistributedInterpol::DistributedInterpol(const Partition &p, Real c1, Real c2,
+                                         Real c3)
+    : DistributedOperator(p, CENTERS_TO_FACES,
+                          {Interpol(p.cells[0], c1), Interpol(p.cells[1], c2),
+                           Interpol(p.cells[2], c3)}) {}
+
+DistributedInterpol::DistributedInterpol(bool type, const Partition &p,
+                                         Real c1, Real c2, Real c3)
+    : DistributedOperator(p, FACES_TO_CENTERS,
+                          {Interpol(type, p.cells[0], c1),
+                           Interpol(type, p.cells[1], c2),
+                           Interpol(type, p.cells[2], c3)}) {}
+
+DistributedLaplacian::DistributedLaplacian(const Partition &p, Real dx,
+                                           Real dy, Real dz)
+    : G(p, dx, dy, dz), D(p, dx, dy, dz), faces(G.range()) {
+  h[0] = dx;
+  h[1] = dy;
+  h[2] = dz;
+}
+
+void DistributedLaplacian::apply(DistributedField &x,
+                                 DistributedField &y) const {
+  G.apply(x, faces);
+  D.apply(faces, y);
+}
+
+sp_mat DistributedLaplacian::local() const {
+  // D*G is the sum of the 1-D Laplacians along each axis, on the
+  // centers of the other axes
+  const Partition &p = faces.partition();
+  std::vector<sp_mat> A;
+  for (u16 d = 0; d < 3; ++d)
+    A.push_back(Laplacian(p.k, p.cells[d], h[d]));
+
+  return assemble(block(p, -1), A, [](u16, u16) { return true; });
+}
+
+DistributedRobinBC::DistributedRobinBC(const Partition &p, Real dx, Real dy,
+                                       Real dz, Real a, Real b) {
+  const Real h[3] = {dx, dy, dz};
+  std::vector<sp_mat> A;
+  for (u16 d = 0; d < 3; ++d)
+    A.push_back(RobinBC(p.k, p.cells[d], h[d], a, b));
+
+  // The x terms skip the y and z boundaries, the y terms the z boundaries
+  this->A = assemble(block(p, -1), A, [](u16 d, u16 e) { return e > d; });
+}
+
+void DistributedRobinBC::apply(const DistributedField &x,
+                               DistributedField &y) const {
+  assert(x.blocks.size() == 1 && y.blocks.size() == 1);
+  y.unpack(y.pack() + A * x.pack());
+}
+
+#endif // MOLE_USE_MPI
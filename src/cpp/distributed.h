@@ -0,0 +1,302 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file distributed.h
+ *
+ * @brief Mimetic operators on a 3-D grid partitioned over MPI ranks
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef DISTRIBUTED_H
+#define DISTRIBUTED_H
+
+#ifdef MOLE_USE_MPI
+
+#include "utils.h"
+#include <memory>
+#include <mpi.h>
+#include <vector>
+
+/**
+ * @brief Block partition of the cells of an m x n x o grid over the ranks
+ * of a communicator
+ *
+ * The ranks form a Cartesian process grid (MPI_Dims_create) and each one
+ * owns a box of cells, at least k along every axis. Boundary nodes belong
+ * to the ranks whose box touches them, and faces along their own axis to
+ * the rank on their right, except for the last face, which belongs to the
+ * last rank. Entries within k/2 of an owned box along an axis are kept as
+ * ghosts, which is as wide as any row of an operator of order k reaches.
+ */
+class Partition {
+public:
+  /**
+   * @brief Partition Constructor
+   *
+   * @param comm Communicator of the ranks sharing the grid
+   * @param k Order of accuracy of the operators
+   * @param m Number of cells in x-direction
+   * @param n Number of cells in y-direction
+   * @param o Number of cells in z-direction
+   */
+  Partition(MPI_Comm comm, u16 k, u32 m, u32 n, u32 o);
+  ~Partition();
+
+  Partition(const Partition &) = delete;
+  Partition &operator=(const Partition &) = delete;
+
+  MPI_Comm comm;     ///< Cartesian communicator
+  int rank, size;    ///< Rank in comm and number of ranks
+  int dims[3];       ///< Ranks along each axis
+  int coords[3];     ///< Position of this rank in the process grid
+  int lower[3];      ///< Neighbor rank below along each axis, or MPI_PROC_NULL
+  int upper[3];      ///< Neighbor rank above along each axis, or MPI_PROC_NULL
+  u16 k;             ///< Order of accuracy
+  u32 cells[3];      ///< Number of cells of the whole grid
+  u32 first[3];      ///< First owned cell along each axis
+  u32 count[3];      ///< Number of owned cells along each axis
+};
+
+/**
+ * @brief The part of a global array owned by a rank, plus its ghosts
+ *
+ * Indices are those of the global array along each axis, so for scalars
+ * node 0 is the west boundary node and node i the center of cell i - 1.
+ */
+struct Block {
+  uword start[3];    ///< First owned index along each axis
+  uword count[3];    ///< Number of owned indices along each axis
+  uword lo[3], hi[3];///< Ghost layers below and above along each axis
+  uword dim[3];      ///< Stored size along each axis, ghosts included
+  uword size;        ///< Number of stored entries
+  uword offset;      ///< Position of the block in DistributedField::values
+  uword global[3];   ///< Size of the global array along each axis
+  uword global_offset; ///< Position of the global array in the full vector
+
+  /**
+   * @brief Position in the block of global index (i, j, l)
+   */
+  uword at(uword i, uword j, uword l) const {
+    return offset + (i - start[0] + lo[0]) +
+           dim[0] * ((j - start[1] + lo[1]) + dim[1] * (l - start[2] + lo[2]));
+  }
+};
+
+/**
+ * @brief Scalar or vector field distributed over the ranks of a Partition
+ *
+ * A scalar field is one block over the centers and boundary nodes, with
+ * ghosts along every axis. A vector field has one block per component,
+ * ordered as the rows of Gradient, with ghosts along its own axis only.
+ * Ghost values are only meaningful after an exchange.
+ */
+class DistributedField {
+public:
+  /**
+   * @brief DistributedField Constructor, all values zero
+   *
+   * @param partition Partition of the grid, must outlive the field
+   * @param faces True for a vector field on the faces
+   */
+  DistributedField(const Partition &partition, bool faces = false);
+
+  /**
+   * @brief Copies the owned entries out of a vector of the whole grid
+   */
+  void scatter(const vec &global);
+
+  /**
+   * @brief The vector of the whole grid, assembled on every rank
+   */
+  vec gather() const;
+
+  /**
+   * @brief The owned entries, block by block with x fastest
+   */
+  vec pack() const;
+
+  /**
+   * @brief Sets the owned entries from pack() order
+   */
+  void unpack(const vec &owned);
+
+  /**
+   * @brief Starts receiving the ghosts from the neighbors
+   *
+   * The owned values must not change until end_exchange().
+   */
+  void begin_exchange();
+
+  /**
+   * @brief Waits for the ghosts started by begin_exchange()
+   */
+  void end_exchange();
+
+  /**
+   * @brief Dot product of the owned entries over all ranks
+   */
+  Real dot(const DistributedField &other) const;
+
+  /**
+   * @brief Number of owned entries on this rank
+   */
+  uword n_owned() const;
+
+  const Partition &partition() const { return *part; }
+
+  std::vector<Block> blocks; ///< Blocks of the field, one per component
+  vec values;                ///< Stored entries of all blocks
+
+private:
+  struct Halo;
+
+  const Partition *part;
+  std::shared_ptr<Halo> halo; // Committed ghost datatypes, shared by copies
+  std::vector<MPI_Request> requests;
+};
+
+/**
+ * @brief A mimetic operator applied to distributed fields
+ *
+ * Every axis keeps the rows of its 1-D operator that produce owned
+ * entries. Rows whose columns are all owned are applied while the ghosts
+ * are in flight, the others once they have arrived.
+ */
+class DistributedOperator {
+public:
+  /**
+   * @brief y = A*x, exchanging the ghosts of x
+   */
+  void apply(DistributedField &x, DistributedField &y) const;
+
+  /**
+   * @brief A field of the size of the result of apply()
+   */
+  DistributedField range() const;
+
+  /**
+   * @brief A field of the size of the argument of apply()
+   */
+  DistributedField domain() const;
+
+protected:
+  enum Kind { GRADIENT, DIVERGENCE, CENTERS_TO_FACES, FACES_TO_CENTERS };
+
+  DistributedOperator(const Partition &partition, Kind kind,
+                      const std::vector<sp_mat> &A);
+
+private:
+  // Owned rows of a 1-D operator along one axis, columns local to the
+  // input block
+  struct Band {
+    std::vector<int> first;
+    std::vector<std::vector<Real>> weights;
+    std::vector<char> inner;  // Uses owned columns only
+  };
+
+  // y block += band along axis applied to x block, over an output box
+  struct Term {
+    u16 axis;
+    Block in, out;            // Blocks of x and y
+    uword lo[3], hi[3];       // Output box, local indices
+    int shift[3];             // Input index minus output index, other axes
+    Band band;
+  };
+
+  void apply(const Term &t, const Real *x, Real *y, bool inner) const;
+
+  const Partition &part;
+  Kind kind;
+  std::vector<Term> terms;
+};
+
+/**
+ * @brief Distributed mimetic Gradient, as Gradient(k, m, n, o, dx, dy, dz)
+ */
+class DistributedGradient : public DistributedOperator {
+public:
+  DistributedGradient(const Partition &partition, Real dx, Real dy, Real dz);
+};
+
+/**
+ * @brief Distributed mimetic Divergence, as Divergence(k, m, n, o, dx, dy, dz)
+ */
+class DistributedDivergence : public DistributedOperator {
+public:
+  DistributedDivergence(const Partition &partition, Real dx, Real dy, Real dz);
+};
+
+/**
+ * @brief Distributed mimetic Interpolator, as Interpol(m, n, o, c1, c2, c3)
+ * or, with type, Interpol(true, m, n, o, c1, c2, c3)
+ */
+class DistributedInterpol : public DistributedOperator {
+public:
+  DistributedInterpol(const Partition &partition, Real c1, Real c2, Real c3);
+  DistributedInterpol(bool type, const Partition &partition, Real c1, Real c2,
+                      Real c3);
+};
+
+/**
+ * @brief Distributed mimetic Laplacian, as Laplacian(k, m, n, o, dx, dy, dz)
+ *
+ * Applied as D*(G*x) with a face field in between, so the ghosts stay
+ * k/2 wide at the cost of a second exchange.
+ */
+class DistributedLaplacian {
+public:
+  DistributedLaplacian(const Partition &partition, Real dx, Real dy, Real dz);
+
+  /**
+   * @brief y = L*x, exchanging the ghosts of x
+   */
+  void apply(DistributedField &x, DistributedField &y) const;
+
+  /**
+   * @brief Rows and columns of L of the owned scalars, in pack() order
+   */
+  sp_mat local() const;
+
+  const DistributedGradient G;   ///< Gradient of the partition
+  const DistributedDivergence D; ///< Divergence of the partition
+
+private:
+  mutable DistributedField faces;
+  Real h[3];
+};
+
+/**
+ * @brief Distributed mimetic Robin boundary condition, as
+ * RobinBC(k, m, dx, n, dy, o, dz, a, b)
+ *
+ * Its rows reach at most k nodes into the grid, which every rank owns, so
+ * it is kept as the local block of owned rows and columns and needs no
+ * exchange.
+ */
+class DistributedRobinBC {
+public:
+  DistributedRobinBC(const Partition &partition, Real dx, Real dy, Real dz,
+                     Real a, Real b);
+
+  /**
+   * @brief y += BC*x on the owned entries
+   */
+  void apply(const DistributedField &x, DistributedField &y) const;
+
+  /**
+   * @brief Rows and columns of BC of the owned scalars, in pack() order
+   */
+  const sp_mat &local() const { return A; }
+
+private:
+  sp_mat A;
+};
+
+#endif // MOLE_USE_MPI
+
+#endif // DISTRIBUTED_H
@@ -0,0 +1,91 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file distributedkrylov.cpp
+ *
+ * @brief Krylov solvers and preconditioners across MPI ranks
+ *
+ * @date 2026/10/19
+ */
+
+#ifdef MOLE_USE_MPI
+
+#include "distributedkrylov.h"
+#include <algorithm>
+
+namespace {
+
+// Global number of unknowns
+uword size(MPI_Comm comm, const vec &b) {
+  unsigned long long N = b.n_elem;
+  MPI_Allreduce(MPI_IN_PLACE, &N, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, comm);
+  return N;
+}
+
+} // namespace
+
+Real DistributedKrylov::dot(MPI_Comm comm, const vec &a, const vec &b) {
+  Real sum = arma::dot(a, b);
+  MPI_Allreduce(MPI_IN_PLACE, &sum, 1, MPI_DOUBLE, MPI_SUM, comm);
+  return sum;
+}
+
+Krylov::Inner DistributedKrylov::inner(MPI_Comm comm) {
+  return [comm](const vec &a, const vec &b) { return dot(comm, a, b); };
+}
+
+KrylovInfo DistributedKrylov::cg(MPI_Comm comm, const Krylov::Operator &A,
+                                 const vec &b, vec &x,
+                                 const Krylov::Operator &M, Real tol,
+                                 u32 maxit) {
+  if (maxit == 0)
+    maxit = size(comm, b);
+
+  return Krylov::cg(A, b, x, M, tol, maxit, inner(comm));
+}
+
+KrylovInfo DistributedKrylov::gmres(MPI_Comm comm, const Krylov::Operator &A,
+                                    const vec &b, vec &x,
+                                    const Krylov::Operator &M, Real tol,
+                                    u32 maxit, u32 restart) {
+  uword global = size(comm, b);
+
+  if (maxit == 0)
+    maxit = global;
+
+  restart = std::min<uword>(restart, global);
+
+  return Krylov::gmres(A, b, x, M, tol, maxit, restart, inner(comm));
+}
+
+DistributedPoisson::DistributedPoisson(const Partition &p, Real dx, Real dy,
+                                       Real dz, Real a, Real b)
+    : L(p, dx, dy, dz), BC(p, dx, dy, dz, a, b), u(p), v(p) {}
+
+void DistributedPoisson::apply(const vec &x, vec &y) const {
+  u.unpack(x);
+  L.apply(u, v);
+  BC.apply(u, v);
+  y = v.pack();
+}
+
+Krylov::Operator DistributedPoisson::op() const {
+  return [this](const vec &x, vec &y) { apply(x, y); };
+}
+
+BlockJacobi::BlockJacobi(const sp_mat &local, const std::string &backend)
+    : solver(LinearSolver::create(backend)) {
+  solver->factorise(local);
+}
+
+void BlockJacobi::apply(const vec &r, vec &z) { z = solver->solve(r); }
+
+Krylov::Operator BlockJacobi::preconditioner() {
+  return [this](const vec &r, vec &z) { apply(r, z); };
+}
+
+#endif // MOLE_USE_MPI
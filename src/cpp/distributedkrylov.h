@@ -0,0 +1,155 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file distributedkrylov.h
+ *
+ * @brief Krylov solvers and preconditioners across MPI ranks
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef DISTRIBUTEDKRYLOV_H
+#define DISTRIBUTEDKRYLOV_H
+
+#ifdef MOLE_USE_MPI
+
+#include "distributed.h"
+#include "krylov.h"
+#include "solver.h"
+#include <memory>
+#include <string>
+
+/**
+ * @brief Krylov solvers for systems distributed over the ranks of a
+ * communicator
+ *
+ * Every rank holds the entries it owns, as given by
+ * DistributedField::pack(), and the Operators act on those as in Krylov.
+ * The iterations are those of Krylov, run with inner() as their inner
+ * product, so all ranks take the same steps and stop together.
+ */
+class DistributedKrylov {
+public:
+  /**
+   * @brief Inner product of two distributed vectors
+   */
+  static Real dot(MPI_Comm comm, const vec &a, const vec &b);
+
+  /**
+   * @brief dot() on comm as a Krylov::Inner
+   */
+  static Krylov::Inner inner(MPI_Comm comm);
+
+  /**
+   * @brief Preconditioned Conjugate Gradient
+   *
+   * @param comm communicator of the ranks sharing the system
+   * @param A symmetric positive (semi)definite operator
+   * @param b RHS of Ax=b, owned entries
+   * @param x initial guess on entry (zero if empty), solution on exit
+   * @param M symmetric positive definite preconditioner, identity if empty
+   * @param tol relative residual tolerance
+   * @param maxit maximum number of iterations, the system size if zero
+   */
+  static KrylovInfo cg(MPI_Comm comm, const Krylov::Operator &A,
+                       const vec &b, vec &x,
+                       const Krylov::Operator &M = nullptr, Real tol = 1e-10,
+                       u32 maxit = 0);
+
+  /**
+   * @brief Right preconditioned restarted GMRES
+   *
+   * @param comm communicator of the ranks sharing the system
+   * @param A square operator
+   * @param b RHS of Ax=b, owned entries
+   * @param x initial guess on entry (zero if empty), solution on exit
+   * @param M preconditioner, identity if empty
+   * @param tol relative residual tolerance
+   * @param maxit maximum number of iterations, the system size if zero
+   * @param restart dimension of the Krylov subspace between restarts
+   */
+  static KrylovInfo gmres(MPI_Comm comm, const Krylov::Operator &A,
+                          const vec &b, vec &x,
+                          const Krylov::Operator &M = nullptr,
+                          Real tol = 1e-10, u32 maxit = 0, u32 restart = 30);
+};
+
+/**
+ * @brief Mimetic Poisson operator L + BC of a Partition, on the owned
+ * scalars
+ *
+ * The distributed counterpart of Laplacian(k, m, n, o, dx, dy, dz) +
+ * RobinBC(k, m, dx, n, dy, o, dz, a, b).
+ */
+class DistributedPoisson {
+public:
+  DistributedPoisson(const Partition &partition, Real dx, Real dy, Real dz,
+                     Real a, Real b);
+
+  /**
+   * @brief y = (L + BC)*x on the owned entries
+   */
+  void apply(const vec &x, vec &y) const;
+
+  /**
+   * @brief The operator as a Krylov::Operator, must outlive it
+   */
+  Krylov::Operator op() const;
+
+  /**
+   * @brief Rows and columns of L + BC of the owned scalars
+   */
+  sp_mat local() const { return L.local() + BC.local(); }
+
+  const DistributedLaplacian L; ///< Laplacian of the partition
+  const DistributedRobinBC BC;  ///< Boundary condition of the partition
+
+private:
+  mutable DistributedField u, v;
+};
+
+/**
+ * @brief Block Jacobi preconditioner
+ *
+ * Every rank factorises the block of the owned rows and columns of the
+ * system once, with any LinearSolver backend, and applies its inverse to
+ * its part of the residual. No communication is needed, but the number of
+ * iterations grows with the number of ranks.
+ */
+class BlockJacobi {
+public:
+  /**
+   * @brief BlockJacobi Constructor
+   *
+   * @param local the block of this rank, e.g. DistributedPoisson::local()
+   * @param backend LinearSolver backend for its factorization
+   */
+  BlockJacobi(const sp_mat &local,
+              const std::string &backend = LinearSolver::default_backend());
+
+  /**
+   * @brief Applies the preconditioner, z = M^-1 r
+   */
+  void apply(const vec &r, vec &z);
+
+  /**
+   * @brief The preconditioner as a Krylov::Operator, valid while this lives
+   */
+  Krylov::Operator preconditioner();
+
+  /**
+   * @brief Timings of the local factorization and of the last solve
+   */
+  const SolverStats &stats() const { return solver->stats(); }
+
+private:
+  std::unique_ptr<LinearSolver> solver;
+};
+
+#endif // MOLE_USE_MPI
+
+#endif // DISTRIBUTEDKRYLOV_H
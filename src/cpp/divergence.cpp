@@ -14,11 +14,13 @@
  */
 
 #include "divergence.h"
+#include "mimetic.h"
+#include <stdexcept>
 
 // 1-D Constructor
 Divergence::Divergence(u16 k, u32 m, Real dx) : sp_mat(m + 2, m + 1) {
   assert(!(k % 2));
-  assert(k > 1 && k < 7);
+  assert(k > 1);
   assert(m > 2 * k);
 
   switch (k) {
@@ -100,10 +102,30 @@ Divergence::Divergence(u16 k, u32 m, Real dx) : sp_mat(m + 2, m + 1) {
       , 1706.0 / 1457.0 , 3124.0 / 5901.0 , 887.0 / 531.0 , 929.0 / 2002.0
       , 2383.0 / 2005.0 };
     break;
+  default: {
+    // Higher orders are generated
+    const MimeticStencils &s = Mimetic::stencils(k);
+    // A and A'
+    for (u32 r = 0; r + 1 < k / 2u; r++) {
+      for (u32 c = 0; c <= k; c++) {
+        at(r + 1, c) = s.divergence[r][c];
+        at(m - r, m - c) = -s.divergence[r][c];
+      }
+    }
+    // Middle
+    for (u32 i = k / 2; i <= m + 1 - k / 2; i++)
+      for (u32 c = 0; c < k; c++)
+        at(i, i - k / 2 + c) = s.interior[c];
+    // Weights
+    Q = conv_to<vec>::from(s.Q);
+    break;
+  }
   }
 
   // Scaling
   *this /= dx;
+  J.assign(1, ones<vec>(m + 2) / dx);
+  J[0](0) = J[0](m + 1) = 0;
 }
 
 // 2-D Constructor
@@ -111,6 +133,98 @@ Divergence::Divergence(u16 k, u32 m, u32 n, Real dx, Real dy) {
   Divergence Dx(k, m, dx);
   Divergence Dy(k, n, dy);
 
+  *this = assemble(Dx, Dy);
+  J = {Dx.J[0], Dy.J[0]};
+}
+
+// 3-D Constructor
+Divergence::Divergence(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz) {
+  Divergence Dx(k, m, dx);
+  Divergence Dy(k, n, dy);
+  Divergence Dz(k, o, dz);
+
+  *this = assemble(Dx, Dy, Dz);
+  J = {Dx.J[0], Dy.J[0], Dz.J[0]};
+}
+
+// 1-D Non-uniform Constructor
+Divergence::Divergence(u16 k, const vec &ticks) {
+  Divergence D(k, ticks.n_elem - 1, 1.0);
+
+  // Jacobian of the grid at the centers from the unscaled operator, the
+  // boundary rows are empty
+  vec metric = D * ticks;
+  uword m = ticks.n_elem - 1;
+
+  J.assign(1, vec(m + 2, fill::zeros));
+  for (uword i = 1; i <= m; ++i) {
+    if (metric(i) <= 0)
+      throw std::invalid_argument("Divergence: ticks must be increasing");
+    J[0](i) = 1.0 / metric(i);
+  }
+  *this = sp_mat(diagmat(J[0])) * D;
+  Q = D.Q;
+}
+
+// 2-D Non-uniform Constructor
+Divergence::Divergence(u16 k, const vec &xticks, const vec &yticks) {
+  Divergence Dx(k, xticks);
+  Divergence Dy(k, yticks);
+
+  *this = assemble(Dx, Dy);
+  J = {Dx.J[0], Dy.J[0]};
+}
+
+// 3-D Non-uniform Constructor
+Divergence::Divergence(u16 k, const vec &xticks, const vec &yticks,
+                       const vec &zticks) {
+  Divergence Dx(k, xticks);
+  Divergence Dy(k, yticks);
+  Divergence Dz(k, zticks);
+
+  *this = assemble(Dx, Dy, Dz);
+  J = {Dx.J[0], Dy.J[0], Dz.J[0]};
+}
+
+// Curvilinear Constructor
+Divergence::Divergence(u16 k, const Jacobian &jacobian) {
+  const std::vector<u32> &c = jacobian.cells;
+  u16 dim = jacobian.dimension();
+
+  // Logical divergence on the unit-spaced grid, split by face orientation
+  sp_mat D = dim == 2
+                 ? sp_mat(Divergence(k, c[0], c[1], 1.0, 1.0))
+                 : sp_mat(Divergence(k, c[0], c[1], c[2], 1.0, 1.0, 1.0));
+
+  // Metrics at the centers and boundary nodes
+  sp_mat T = jacobian.nodes_to(dim);
+  vec J = T * jacobian.J;
+
+  // Component d lives on the faces normal to axis d, its derivatives along
+  // the other axes are taken at the centers from neighbouring faces
+  uword col = 0;
+  for (u16 d = 0; d < dim; ++d) {
+    uword faces = 1;
+    for (u16 b = 0; b < dim; ++b)
+      faces *= b == d ? c[b] + 1 : c[b];
+
+    sp_mat Dd(D.n_rows, faces);
+    for (u16 a = 0; a < dim; ++a) {
+      vec w = (T * jacobian.cofactor(d, a)) / J;
+      if (a == d)
+        Dd += sp_mat(diagmat(w)) * D.cols(col, col + faces - 1);
+      else
+        Dd += sp_mat(diagmat(w)) * jacobian.derivative(d, a);
+    }
+
+    *this = d == 0 ? Dd : Utils::spjoin_rows(*this, Dd);
+    col += faces;
+  }
+}
+
+sp_mat Divergence::assemble(const sp_mat &Dx, const sp_mat &Dy) {
+  u32 m = Dx.n_rows - 2, n = Dy.n_rows - 2;
+
   sp_mat Im = speye(m + 2, m + 2);
   sp_mat In = speye(n + 2, n + 2);
 
@@ -124,20 +238,17 @@ Divergence::Divergence(u16 k, u32 m, u32 n, Real dx, Real dy) {
 
   // Dimensions = (m+2)*(n+2), 2*m*n+m+n
   if (m != n)
-    *this = Utils::spjoin_rows(D1, D2);
-  else {
-    sp_mat A1(1, 2);
-    sp_mat A2(1, 2);
-    A1(0, 0) = A2(0, 1) = 1.0;
-    *this = Utils::spkron(A1, D1) + Utils::spkron(A2, D2);
-  }
+    return Utils::spjoin_rows(D1, D2);
+
+  sp_mat A1(1, 2);
+  sp_mat A2(1, 2);
+  A1(0, 0) = A2(0, 1) = 1.0;
+  return Utils::spkron(A1, D1) + Utils::spkron(A2, D2);
 }
 
-// 3-D Constructor
-Divergence::Divergence(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz) {
-  Divergence Dx(k, m, dx);
-  Divergence Dy(k, n, dy);
-  Divergence Dz(k, o, dz);
+sp_mat Divergence::assemble(const sp_mat &Dx, const sp_mat &Dy,
+                            const sp_mat &Dz) {
+  u32 m = Dx.n_rows - 2, n = Dy.n_rows - 2, o = Dz.n_rows - 2;
 
   sp_mat Im = speye(m + 2, m + 2);
   sp_mat In = speye(n + 2, n + 2);
@@ -156,16 +267,20 @@ Divergence::Divergence(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz) {
 
   // Dimensions = (m+2)*(n+2)*(o+2), 3*m*n*o+m*n+m*o+n*o
   if ((m != n) || (n != o))
-    *this = Utils::spjoin_rows(Utils::spjoin_rows(D1, D2), D3);
-  else {
-    sp_mat A1(1, 3);
-    sp_mat A2(1, 3);
-    sp_mat A3(1, 3);
-    A1(0, 0) = A2(0, 1) = A3(0, 2) = 1.0;
-    *this =
-        Utils::spkron(A1, D1) + Utils::spkron(A2, D2) + Utils::spkron(A3, D3);
-  }
+    return Utils::spjoin_rows(Utils::spjoin_rows(D1, D2), D3);
+
+  sp_mat A1(1, 3);
+  sp_mat A2(1, 3);
+  sp_mat A3(1, 3);
+  A1(0, 0) = A2(0, 1) = A3(0, 2) = 1.0;
+  return Utils::spkron(A1, D1) + Utils::spkron(A2, D2) + Utils::spkron(A3, D3);
 }
 
 // Returns weights
 vec Divergence::getQ() { return Q; }
+
+// Returns the metric of an axis
+vec Divergence::getJ(u16 axis) {
+  assert(axis < J.size());
+  return J[axis];
+}
@@ -16,8 +16,10 @@
 #ifndef DIVERGENCE_H
 #define DIVERGENCE_H
 
+#include "jacobian.h"
 #include "utils.h"
 #include <cassert>
+#include <vector>
 
 /**
  * @brief Mimetic Divergence operator
@@ -60,6 +62,45 @@ public:
    * @param dz Spacing between cells in z-direction
    */  
   Divergence(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz);
+
+  /**
+   * @brief 1-D Non-uniform Mimetic Divergence Constructor
+   *
+   * @param k Order of accuracy
+   * @param ticks Edges' ticks, m + 1 values
+   *
+   * @note getQ() returns the weights of the unit-spaced operator, the
+   * widths of the cells enter through getJ().
+   */
+  Divergence(u16 k, const vec &ticks);
+
+  /**
+   * @brief 2-D Non-uniform Mimetic Divergence Constructor
+   *
+   * @param k Order of accuracy
+   * @param xticks Edges' ticks in x-direction
+   * @param yticks Edges' ticks in y-direction
+   */
+  Divergence(u16 k, const vec &xticks, const vec &yticks);
+
+  /**
+   * @brief 3-D Non-uniform Mimetic Divergence Constructor
+   *
+   * @param k Order of accuracy
+   * @param xticks Edges' ticks in x-direction
+   * @param yticks Edges' ticks in y-direction
+   * @param zticks Edges' ticks in z-direction
+   */
+  Divergence(u16 k, const vec &xticks, const vec &yticks, const vec &zticks);
+
+  /**
+   * @brief 2-D or 3-D Curvilinear Mimetic Divergence Constructor, as in
+   * div2DCurv.m and div3DCurv.m
+   *
+   * @param k Order of accuracy
+   * @param jacobian Metrics of the grid
+   */
+  Divergence(u16 k, const Jacobian &jacobian);
   
   /**
    * @brief Returns the weights used in the Mimeitc Divergence Operators.
@@ -68,7 +109,22 @@ public:
    */    
   vec getQ();
 
+  /**
+   * @brief Returns the metric of an axis, 1 / (D ticks) at the centers and
+   * zero at the boundary nodes
+   *
+   * @note computed once at construction, 1 / dx for uniform operators.
+   * Not available for curvilinear operators.
+   */
+  vec getJ(u16 axis = 0);
+
 private:
+  // 1-D operators joined into a 2-D or 3-D one
+  static sp_mat assemble(const sp_mat &Dx, const sp_mat &Dy);
+  static sp_mat assemble(const sp_mat &Dx, const sp_mat &Dy,
+                         const sp_mat &Dz);
+
+  std::vector<vec> J;
   vec Q;
 };
 
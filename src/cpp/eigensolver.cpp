@@ -0,0 +1,184 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file eigensolver.cpp
+ *
+ * @brief Sparse shift-invert eigensolver for mimetic operators
+ *
+ * @date 2026/10/19
+ */
+
+#include "eigensolver.h"
+#include <algorithm>
+#include <cassert>
+#include <random>
+
+Eigensolver::Eigensolver(const sp_mat &A, Real sigma,
+                         const std::string &backend)
+    : n(A.n_rows), sigma(sigma), factor(LinearSolver::create(backend)) {
+  assert(A.is_square());
+
+  sp_mat I = speye(A.n_rows, A.n_cols);
+  factor->factorise(A - sigma * I);
+}
+
+Eigensolver::Eigensolver(const sp_mat &A, const sp_mat &B, Real sigma,
+                         const std::string &backend)
+    : n(A.n_rows), sigma(sigma), B(B), factor(LinearSolver::create(backend)) {
+  assert(A.is_square());
+  assert(A.n_rows == B.n_rows && A.n_cols == B.n_cols);
+
+  factor->factorise(A - sigma * B);
+}
+
+// Orthonormalizes v against the first j columns of V, twice for stability.
+// Returns false if v lies (numerically) in their span.
+static bool orthonormalize(const mat &V, uword j, vec &v) {
+  Real vnorm = norm(v);
+
+  for (int pass = 0; pass < 2 && j > 0; ++pass)
+    v -= V.cols(0, j - 1) * (V.cols(0, j - 1).t() * v);
+
+  Real proj = norm(v);
+  if (proj <= 1e-12 * vnorm || proj == 0)
+    return false;
+
+  v /= proj;
+  return true;
+}
+
+// A fresh direction orthonormal to the first j columns of V
+static vec restart_vector(const mat &V, uword j, std::mt19937 &gen) {
+  std::uniform_real_distribution<Real> dist(-1, 1);
+  vec v(V.n_rows);
+
+  do {
+    v.imbue([&]() { return dist(gen); });
+  } while (!orthonormalize(V, j, v));
+
+  return v;
+}
+
+EigenInfo Eigensolver::solve(cx_vec &eigval, cx_mat &eigvec, u32 nev,
+                             Real tol, u32 maxit, u32 ncv) const {
+  assert(nev > 0 && nev + 2 <= n);
+
+  if (ncv == 0)
+    ncv = std::max(2 * nev + 2, 20u);
+  ncv = std::min<uword>(ncv, n);
+  assert(ncv >= nev + 2);
+
+  // Ritz vectors kept across a restart, the rest of the basis is rebuilt
+  uword keep = std::min<uword>(nev + (ncv - nev) / 2, ncv - 1);
+
+  EigenInfo info;
+  std::mt19937 gen(5489u);
+
+  // Basis V and its image W = OP*V, so H = V'OP V needs no extra products
+  mat V(n, ncv);
+  mat W(n, ncv);
+  vec v = restart_vector(V, 0, gen);
+  vec w(n);
+  uword j = 0;
+
+  cx_vec theta;
+  cx_mat Y;
+  uvec order;
+  vec res(nev);
+
+  while (true) {
+    // Arnoldi expansion, v always holds the next orthonormal direction
+    for (; j < ncv; ++j) {
+      V.col(j) = v;
+
+      if (B.n_rows)
+        w = factor->solve(B * v);
+      else
+        w = factor->solve(v);
+      W.col(j) = w;
+      ++info.products;
+
+      v = w;
+      if (!orthonormalize(V, j + 1, v))
+        v = restart_vector(V, j + 1, gen);
+    }
+
+    // Rayleigh-Ritz, largest |theta| are the eigenvalues nearest to sigma
+    mat H = V.t() * W;
+    eig_gen(theta, Y, H);
+    order = sort_index(abs(theta), "descend");
+
+    info.converged = 0;
+    for (uword i = 0; i < nev; ++i) {
+      mat y_re = real(Y.col(order(i)));
+      mat y_im = imag(Y.col(order(i)));
+      cx_double t = theta(order(i));
+
+      vec r_re = W * y_re - V * (t.real() * y_re - t.imag() * y_im);
+      vec r_im = W * y_im - V * (t.real() * y_im + t.imag() * y_re);
+
+      res(i) = std::sqrt(dot(r_re, r_re) + dot(r_im, r_im)) / std::abs(t);
+      if (res(i) <= tol)
+        ++info.converged;
+    }
+
+    if (info.converged == nev || info.restarts == maxit)
+      break;
+
+    // Thick restart on a real basis of the leading Ritz vectors, complex
+    // conjugate pairs contribute their real and imaginary parts together
+    mat Z(ncv, keep);
+    uword q = 0;
+
+    for (uword i = 0; i < ncv && q < keep; ++i) {
+      cx_double t = theta(order(i));
+
+      if (t.imag() == 0) {
+        Z.col(q++) = real(Y.col(order(i)));
+      } else if (i == 0 || theta(order(i - 1)) != std::conj(t)) {
+        if (q + 2 > keep)
+          break;
+        Z.col(q++) = real(Y.col(order(i)));
+        Z.col(q++) = imag(Y.col(order(i)));
+      }
+    }
+
+    mat U, R;
+    qr_econ(U, R, Z.cols(0, q - 1));
+
+    // The residuals of all Ritz pairs are parallel to v, so the restarted
+    // basis [V*U, v] still spans a Krylov subspace
+    mat VU = V * U;
+    mat WU = W * U;
+    V.cols(0, q - 1) = VU;
+    W.cols(0, q - 1) = WU;
+    j = q;
+
+    ++info.restarts;
+  }
+
+  eigval.set_size(nev);
+  eigvec.set_size(n, nev);
+
+  for (uword i = 0; i < nev; ++i) {
+    cx_vec y = Y.col(order(i));
+    eigval(i) = sigma + 1.0 / theta(order(i));
+    eigvec.col(i) = cx_mat(V * real(y), V * imag(y));
+  }
+
+  info.residual = max(res);
+
+  return info;
+}
+
+cx_vec Eigensolver::eigenvalues(u32 nev, Real tol) const {
+  cx_vec eigval;
+  cx_mat eigvec;
+  solve(eigval, eigvec, nev, tol);
+
+  return eigval;
+}
@@ -0,0 +1,97 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file eigensolver.h
+ *
+ * @brief Sparse shift-invert eigensolver for mimetic operators
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef EIGENSOLVER_H
+#define EIGENSOLVER_H
+
+#include "solver.h"
+
+/**
+ * @brief Convergence report of an eigensolve
+ *
+ */
+struct EigenInfo {
+  u32 restarts = 0;   ///< Restarts of the Arnoldi process
+  u32 products = 0;   ///< Applications of the shift-inverted operator
+  u32 converged = 0;  ///< Number of converged eigenpairs
+  Real residual = 0;  ///< Largest relative residual among the returned pairs
+};
+
+/**
+ * @brief Few eigenpairs of Ax = lambda Bx closest to a shift sigma
+ *
+ * Runs a thick-restarted Arnoldi process on (A - sigma B)^-1 B, whose
+ * dominant eigenvalues 1/(lambda - sigma) belong to the eigenvalues of A
+ * nearest to sigma. A - sigma B is factorised once, at construction, and
+ * reused by every solve() call, so only the m x ncv basis is dense. Any
+ * direct LinearSolver backend can do the factorization.
+ *
+ * A need not be symmetric, eigenvalues are returned as complex numbers.
+ * Placing sigma below the spectrum yields the lowest eigenvalues, e.g. the
+ * energy levels of a Hamiltonian -0.5L + V.
+ */
+class Eigensolver {
+public:
+  /**
+   * @brief Eigensolver for the standard problem Ax = lambda x
+   *
+   * @param A a square sparse matrix
+   * @param sigma shift, eigenvalues nearest to it are computed
+   * @param backend LinearSolver backend that factorises A - sigma I
+   */
+  Eigensolver(const sp_mat &A, Real sigma = 0,
+              const std::string &backend = LinearSolver::default_backend());
+
+  /**
+   * @brief Eigensolver for the generalized problem Ax = lambda Bx
+   *
+   * @param A a square sparse matrix
+   * @param B a square sparse matrix, e.g. the weight of a Sturm-Liouville
+   * problem
+   * @param sigma shift, eigenvalues nearest to it are computed
+   * @param backend LinearSolver backend that factorises A - sigma B
+   */
+  Eigensolver(const sp_mat &A, const sp_mat &B, Real sigma = 0,
+              const std::string &backend = LinearSolver::default_backend());
+
+  /**
+   * @brief Computes the nev eigenpairs nearest to the shift
+   *
+   * @param eigval eigenvalues, sorted by distance to the shift
+   * @param eigvec unit norm eigenvectors, one per column
+   * @param nev number of eigenpairs
+   * @param tol relative residual tolerance ||Ax - lambda Bx|| / |lambda - sigma|
+   * in the shift-inverted norm
+   * @param maxit maximum number of restarts
+   * @param ncv dimension of the search space, max(2 nev + 2, 20) if zero
+   */
+  EigenInfo solve(cx_vec &eigval, cx_mat &eigvec, u32 nev, Real tol = 1e-10,
+                  u32 maxit = 300, u32 ncv = 0) const;
+
+  /**
+   * @brief Computes the nev eigenvalues nearest to the shift
+   *
+   * @param nev number of eigenvalues
+   * @param tol relative residual tolerance
+   */
+  cx_vec eigenvalues(u32 nev, Real tol = 1e-10) const;
+
+private:
+  uword n;                              // System size
+  Real sigma;
+  sp_mat B;                             // Empty for the standard problem
+  std::shared_ptr<LinearSolver> factor; // Factorization of A - sigma B
+};
+
+#endif // EIGENSOLVER_H
@@ -0,0 +1,189 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file expmv.cpp
+ *
+ * @brief Action of the matrix exponential, exp(tA)v
+ *
+ * @date 2026/10/19
+ */
+
+#include "expmv.h"
+#include <cassert>
+#include <stdexcept>
+
+// Rounds a step size up to two significant digits, as Expokit does
+static Real round_step(Real t) {
+  Real s = std::pow(10.0, std::floor(std::log10(t)) - 1);
+  return std::ceil(t / s) * s;
+}
+
+Expmv::Expmv(const sp_mat &A, Real tol, u32 krylov)
+    : anorm(norm(A, "inf")), tol(tol), m(krylov) {
+  assert(A.n_rows == A.n_cols);
+  assert(krylov >= 2);
+
+  // Keeps its own copy, so A may go out of scope
+  sp_mat copy = A;
+  this->A = [copy](const vec &x, vec &y) { y = copy * x; };
+}
+
+Expmv::Expmv(const Krylov::Operator &A, Real norm, Real tol, u32 krylov)
+    : A(A), anorm(norm), tol(tol), m(krylov) {
+  assert(krylov >= 2);
+}
+
+ExpmvInfo Expmv::apply(Real t, const vec &v, vec &w) const {
+  return expv(A, t, v, w);
+}
+
+ExpmvInfo Expmv::apply(Real t, const cx_vec &v, cx_vec &w) const {
+  // w' = iAw is the real system [a; b]' = [0 -A; A 0] [a; b], whose
+  // infinity norm is the one of A
+  uword n = v.n_elem;
+  vec Ax(n), Ay(n);
+
+  Krylov::Operator B = [&](const vec &x, vec &y) {
+    A(x.tail(n), Ay);
+    A(x.head(n), Ax);
+    y.set_size(2 * n);
+    y.head(n) = -Ay;
+    y.tail(n) = Ax;
+  };
+
+  vec stacked = join_cols(vec(real(v)), vec(imag(v)));
+  vec result;
+  ExpmvInfo info = expv(B, t, stacked, result);
+
+  w = cx_vec(result.head(n), result.tail(n));
+  return info;
+}
+
+ExpmvInfo Expmv::expv(const Krylov::Operator &A, Real t, const vec &v,
+                      vec &w) const {
+  const uword n = v.n_elem;
+  const u32 mmax = std::min<uword>(m, n);
+  const Real gamma = 0.9, delta = 1.2;
+  const Real btol = 1e-7 * tol;   // Happy breakdown
+  const u32 max_rejections = 10;
+
+  ExpmvInfo info;
+  w = v;
+
+  Real beta = norm(w);
+  if (beta == 0 || t == 0)
+    return info;
+  if (anorm == 0)
+    return info;
+
+  const Real sgn = t > 0 ? 1 : -1;
+  const Real t_out = std::abs(t);
+
+  // First substep from the a priori bound of the Krylov error
+  Real xm = 1.0 / mmax;
+  Real fact = std::pow((mmax + 1) / std::exp(1.0), mmax + 1) *
+              std::sqrt(2 * M_PI * (mmax + 1));
+  Real t_new = round_step(
+      (1 / anorm) * std::pow((fact * tol) / (4 * beta * anorm), xm));
+
+  mat V(n, mmax + 1);
+  mat H(mmax + 2, mmax + 2);
+  vec p(n);
+  Real t_now = 0;
+
+  while (t_now < t_out) {
+    Real t_step = std::min(t_out - t_now, t_new);
+
+    // Arnoldi with modified Gram-Schmidt
+    V.col(0) = w / beta;
+    H.zeros();
+    u32 mb = mmax, k1 = 2;
+
+    for (u32 j = 0; j < mmax; ++j) {
+      A(V.col(j), p);
+      ++info.products;
+
+      for (u32 i = 0; i <= j; ++i) {
+        H(i, j) = dot(V.col(i), p);
+        p -= H(i, j) * V.col(i);
+      }
+
+      Real s = norm(p);
+      if (s < btol) {
+        // The Krylov space is invariant, the rest of the step is exact
+        k1 = 0;
+        mb = j + 1;
+        t_step = t_out - t_now;
+        break;
+      }
+
+      H(j + 1, j) = s;
+      V.col(j + 1) = p / s;
+    }
+
+    Real avnorm = 0;
+    if (k1 != 0) {
+      H(mmax + 1, mmax) = 1;
+      A(V.col(mmax), p);
+      ++info.products;
+      avnorm = norm(p);
+    }
+
+    // Shrink the substep until the error estimate is small enough
+    mat F;
+    Real err_loc = btol;
+    u32 rejections = 0;
+
+    while (true) {
+      u32 mx = mb + k1;
+      F = expmat((sgn * t_step) * H.submat(0, 0, mx - 1, mx - 1));
+
+      if (k1 == 0)
+        break;
+
+      Real phi1 = std::abs(beta * F(mmax, 0));
+      Real phi2 = std::abs(beta * F(mmax + 1, 0) * avnorm);
+
+      if (phi1 > 10 * phi2) {
+        err_loc = phi2;
+        xm = 1.0 / mmax;
+      } else if (phi1 > phi2) {
+        err_loc = (phi1 * phi2) / (phi1 - phi2);
+        xm = 1.0 / mmax;
+      } else {
+        err_loc = phi1;
+        xm = 1.0 / (mmax - 1);
+      }
+
+      if (err_loc <= delta * t_step * tol)
+        break;
+
+      if (++rejections > max_rejections)
+        throw std::runtime_error("Expmv: requested tolerance too tight");
+
+      ++info.rejected;
+      t_step = round_step(gamma * t_step *
+                          std::pow(t_step * tol / err_loc, xm));
+    }
+
+    u32 mx = mb + (k1 > 0 ? k1 - 1 : 0);
+    w = V.cols(0, mx - 1) * (beta * F.submat(0, 0, mx - 1, 0));
+    beta = norm(w);
+
+    t_now += t_step;
+    ++info.substeps;
+    info.error += std::max(err_loc, 1e-16 * beta);
+
+    t_new = round_step(gamma * t_step *
+                       std::pow(t_step * tol / std::max(err_loc, 1e-300), xm));
+
+    if (beta == 0)
+      break;
+  }
+
+  return info;
+}
@@ -0,0 +1,85 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file expmv.h
+ *
+ * @brief Action of the matrix exponential, exp(tA)v
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef EXPMV_H
+#define EXPMV_H
+
+#include "krylov.h"
+
+/**
+ * @brief Work and error estimate of an exponential propagation
+ *
+ */
+struct ExpmvInfo {
+  u32 substeps = 0; ///< Accepted Krylov substeps
+  u32 rejected = 0; ///< Rejected (shrunk) substeps
+  u32 products = 0; ///< Operator applications
+  Real error = 0;   ///< Estimated error, summed over the substeps
+};
+
+/**
+ * @brief Krylov propagator w = exp(tA)v for a large sparse A
+ *
+ * Computes the exponential of the small Arnoldi matrix of A and v instead of
+ * exp(tA), in the manner of Expokit's expv (Sidje, 1998). The interval
+ * [0, t] is split into substeps chosen so that the a posteriori error
+ * estimate of each is below tol * substep. A substep can be much larger than
+ * an explicit time step, so linear problems such as diffusion or the
+ * Schrodinger equation advance in few large steps with error control.
+ */
+class Expmv {
+public:
+  /**
+   * @brief Expmv constructor for an assembled operator
+   *
+   * @param A a square sparse matrix, e.g. a Laplacian with its BC
+   * @param tol absolute error tolerance per unit time
+   * @param krylov Krylov subspace dimension
+   */
+  Expmv(const sp_mat &A, Real tol = 1e-10, u32 krylov = 30);
+
+  /**
+   * @brief Expmv constructor for a matrix-free operator
+   *
+   * @param A square linear operator
+   * @param norm estimate of the infinity norm of A
+   * @param tol absolute error tolerance per unit time
+   * @param krylov Krylov subspace dimension
+   */
+  Expmv(const Krylov::Operator &A, Real norm, Real tol = 1e-10,
+        u32 krylov = 30);
+
+  /**
+   * @brief Computes w = exp(tA)v, t may be negative
+   */
+  ExpmvInfo apply(Real t, const vec &v, vec &w) const;
+
+  /**
+   * @brief Computes w = exp(itA)v, e.g. with A = -H the Schrodinger
+   * propagator exp(-itH)
+   */
+  ExpmvInfo apply(Real t, const cx_vec &v, cx_vec &w) const;
+
+private:
+  // w = exp(tA)v for any real operator
+  ExpmvInfo expv(const Krylov::Operator &A, Real t, const vec &v,
+                 vec &w) const;
+
+  Krylov::Operator A;
+  Real anorm;
+  Real tol;
+  u32 m;
+};
+
+#endif // EXPMV_H
@@ -15,11 +15,13 @@
 
 
  #include "gradient.h"
+#include "mimetic.h"
+#include <stdexcept>
 
 // 1-D Constructor
 Gradient::Gradient(u16 k, u32 m, Real dx) : sp_mat(m + 1, m + 2) {
   assert(!(k % 2));
-  assert(k > 1 && k < 9);
+  assert(k > 1);
   assert(m >= 2 * k);
 
   switch (k) {
@@ -136,104 +138,29 @@ Gradient::Gradient(u16 k, u32 m, Real dx) : sp_mat(m + 1, m + 2) {
       , 1677712.0 / 1359311.0 , 882762.0 / 1402249.0 , 2590978.0 / 1863105.0
       , 420249.0 / 1331069.0 };
     break;
-  case 8:
-    // A
-    at(0, 0) = -4856215.0 / 1200963.0;
-    at(0, 1) = 45858154.0 / 7297397.0;
-    at(0, 2) = -23409299.0 / 4789435.0;
-    at(0, 3) = 3799178.0 / 719717.0;
-    at(0, 4) = -4892189.0 / 1089890.0;
-    at(0, 5) = 1789111.0 / 658879.0;
-    at(0, 6) = -1406819.0 / 1289899.0;
-    at(0, 7) = 1154863.0 / 4436807.0;
-    at(0, 8) = -2936602.0 / 105142673.0;
-    at(1, 0) = 86048.0 / 675675.0;
-    at(1, 1) = -131093.0 / 107520.0;
-    at(1, 2) = 5503131.0 / 5166017.0;
-    at(1, 3) = 305249.0 / 2136437.0;
-    at(1, 4) = -1763845.0 / 8250973.0;
-    at(1, 5) = 1562032.0 / 10745723.0;
-    at(1, 6) = -270419.0 / 4422611.0;
-    at(1, 7) = 2983.0 / 199680.0;
-    at(1, 8) = -2621.0 / 1612800.0;
-    at(2, 0) = -3776.0 / 225225.0;
-    at(2, 1) = 8707.0 / 107520.0;
-    at(2, 2) = -17947.0 / 15360.0;
-    at(2, 3) = 29319.0 / 25600.0;
-    at(2, 4) = -533.0 / 21504.0;
-    at(2, 5) = -263.0 / 9216.0;
-    at(2, 6) = 903.0 / 56320.0;
-    at(2, 7) = -283.0 / 66560.0;
-    at(2, 8) = 257.0 / 537600.0;
-    at(3, 0) = 32.0 / 9009.0;
-    at(3, 1) = -543.0 / 35840.0;
-    at(3, 2) = 265.0 / 3072.0;
-    at(3, 3) = -1233.0 / 1024.0;
-    at(3, 4) = 8625.0 / 7168.0;
-    at(3, 5) = -775.0 / 9216.0;
-    at(3, 6) = 639.0 / 56320.0;
-    at(3, 7) = -15.0 / 13312.0;
-    at(3, 8) = 1.0 / 21504.0;
-    // A'
-    at(m, m + 1) = 4856215.0 / 1200963.0;
-    at(m, m) = -45858154.0 / 7297397.0;
-    at(m, m - 1) = 23409299.0 / 4789435.0;
-    at(m, m - 2) = -3799178.0 / 719717.0;
-    at(m, m - 3) = 4892189.0 / 1089890.0;
-    at(m, m - 4) = -1789111.0 / 658879.0;
-    at(m, m - 5) = 1406819.0 / 1289899.0;
-    at(m, m - 6) = -1154863.0 / 4436807.0;
-    at(m, m - 7) = 2936602.0 / 105142673.0;
-    at(m - 1, m + 1) = -86048.0 / 675675.0;
-    at(m - 1, m) = 131093.0 / 107520.0;
-    at(m - 1, m - 1) = -5503131.0 / 5166017.0;
-    at(m - 1, m - 2) = -305249.0 / 2136437.0;
-    at(m - 1, m - 3) = 1763845.0 / 8250973.0;
-    at(m - 1, m - 4) = -1562032.0 / 10745723.0;
-    at(m - 1, m - 5) = 270419.0 / 4422611.0;
-    at(m - 1, m - 6) = -2983.0 / 199680.0;
-    at(m - 1, m - 7) = 2621.0 / 1612800.0;
-    at(m - 2, m + 1) = 3776.0 / 225225.0;
-    at(m - 2, m) = -8707.0 / 107520.0;
-    at(m - 2, m - 1) = 17947.0 / 15360.0;
-    at(m - 2, m - 2) = -29319.0 / 25600.0;
-    at(m - 2, m - 3) = 533.0 / 21504.0;
-    at(m - 2, m - 4) = 263.0 / 9216.0;
-    at(m - 2, m - 5) = -903.0 / 56320.0;
-    at(m - 2, m - 6) = 283.0 / 66560.0;
-    at(m - 2, m - 7) = -257.0 / 537600.0;
-    at(m - 3, m + 1) = -32.0 / 9009.0;
-    at(m - 3, m) = 543.0 / 35840.0;
-    at(m - 3, m - 1) = -265.0 / 3072.0;
-    at(m - 3, m - 2) = 1233.0 / 1024.0;
-    at(m - 3, m - 3) = -8625.0 / 7168.0;
-    at(m - 3, m - 4) = 775.0 / 9216.0;
-    at(m - 3, m - 5) = -639.0 / 56320.0;
-    at(m - 3, m - 6) = 15.0 / 13312.0;
-    at(m - 3, m - 7) = -1.0 / 21504.0;
-    // Middle
-    for (u32 i = 4; i < m - 3; i++) {
-      at(i, i - 3) = 5.0 / 7168.0;
-      at(i, i - 2) = -49.0 / 5120.0;
-      at(i, i - 1) = 245.0 / 3072.0;
-      at(i, i) = -1225.0 / 1024.0;
-      at(i, i + 1) = 1225.0 / 1024.0;
-      at(i, i + 2) = -245.0 / 3072.0;
-      at(i, i + 3) = 49.0 / 5120.0;
-      at(i, i + 4) = -5.0 / 7168.0;
+  default: {
+    // Higher orders are generated
+    const MimeticStencils &s = Mimetic::stencils(k);
+    // A and A'
+    for (u32 r = 0; r < k / 2u; r++) {
+      for (u32 c = 0; c <= k; c++) {
+        at(r, c) = s.gradient[r][c];
+        at(m - r, m + 1 - c) = -s.gradient[r][c];
+      }
     }
+    // Middle
+    for (u32 i = k / 2; i <= m - k / 2; i++)
+      for (u32 c = 0; c < k; c++)
+        at(i, i - k / 2 + 1 + c) = s.interior[c];
     // Weights
-    P = { 267425.0 / 904736.0 , 2307435.0 / 1517812.0 , 847667.0 / 3066027.0
-      , 4050911.0 / 2301238.0 , 498943.0 / 1084999.0 , 211042.0 / 170117.0
-      , 2065895.0 / 2191686.0 , 1262499.0 / 1258052.0 , 1314891.0 / 1312727.0
-      , 1262499.0 / 1258052.0 , 2065895.0 / 2191686.0 , 211042.0 / 170117.0
-      , 498943.0 / 1084999.0 , 4050911.0 / 2301238.0 , 847667.0 / 3066027.0
-      , 2307435.0 / 1517812.0 , 267425.0 / 904736.0 };
+    P = conv_to<vec>::from(s.P);
     break;
   }
+  }
 
   // Scaling
   *this /= dx;
+  J.assign(1, ones<vec>(m + 1) / dx);
 }
 
 // 2-D Constructor
@@ -241,6 +168,96 @@ Gradient::Gradient(u16 k, u32 m, u32 n, Real dx, Real dy) {
   Gradient Gx(k, m, dx);
   Gradient Gy(k, n, dy);
 
+  *this = assemble(Gx, Gy);
+  J = {Gx.J[0], Gy.J[0]};
+}
+
+// 3-D Constructor
+Gradient::Gradient(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz) {
+  Gradient Gx(k, m, dx);
+  Gradient Gy(k, n, dy);
+  Gradient Gz(k, o, dz);
+
+  *this = assemble(Gx, Gy, Gz);
+  J = {Gx.J[0], Gy.J[0], Gz.J[0]};
+}
+
+// 1-D Non-uniform Constructor
+Gradient::Gradient(u16 k, const vec &ticks) {
+  Gradient G(k, ticks.n_elem - 2, 1.0);
+
+  // Jacobian of the grid at the faces from the unscaled operator
+  vec metric = G * ticks;
+  if (any(metric <= 0))
+    throw std::invalid_argument("Gradient: ticks must be increasing");
+
+  J.assign(1, 1.0 / metric);
+  *this = sp_mat(diagmat(J[0])) * G;
+  P = G.P;
+}
+
+// 2-D Non-uniform Constructor
+Gradient::Gradient(u16 k, const vec &xticks, const vec &yticks) {
+  Gradient Gx(k, xticks);
+  Gradient Gy(k, yticks);
+
+  *this = assemble(Gx, Gy);
+  J = {Gx.J[0], Gy.J[0]};
+}
+
+// 3-D Non-uniform Constructor
+Gradient::Gradient(u16 k, const vec &xticks, const vec &yticks,
+                   const vec &zticks) {
+  Gradient Gx(k, xticks);
+  Gradient Gy(k, yticks);
+  Gradient Gz(k, zticks);
+
+  *this = assemble(Gx, Gy, Gz);
+  J = {Gx.J[0], Gy.J[0], Gz.J[0]};
+}
+
+// Curvilinear Constructor
+Gradient::Gradient(u16 k, const Jacobian &jacobian) {
+  const std::vector<u32> &c = jacobian.cells;
+  u16 dim = jacobian.dimension();
+
+  // Logical gradient on the unit-spaced grid, split by face orientation
+  sp_mat G = dim == 2 ? sp_mat(Gradient(k, c[0], c[1], 1.0, 1.0))
+                      : sp_mat(Gradient(k, c[0], c[1], c[2], 1.0, 1.0, 1.0));
+
+  std::vector<sp_mat> Ga;
+  uword row = 0;
+  for (u16 a = 0; a < dim; ++a) {
+    uword faces = 1;
+    for (u16 b = 0; b < dim; ++b)
+      faces *= b == a ? c[b] + 1 : c[b];
+    Ga.push_back(G.rows(row, row + faces - 1));
+    row += faces;
+  }
+
+  // Component d lives on the faces normal to axis d, where the metrics
+  // cofactor(d, a) / J scale the logical derivatives, interpolated from
+  // the other faces if a != d
+  for (u16 d = 0; d < dim; ++d) {
+    sp_mat T = jacobian.nodes_to(d);
+    vec J = T * jacobian.J;
+
+    sp_mat Gd(Ga[d].n_rows, G.n_cols);
+    for (u16 a = 0; a < dim; ++a) {
+      vec w = (T * jacobian.cofactor(d, a)) / J;
+      if (a == d)
+        Gd += sp_mat(diagmat(w)) * Ga[a];
+      else
+        Gd += sp_mat(diagmat(w)) * (jacobian.faces_to(a, d) * Ga[a]);
+    }
+
+    *this = d == 0 ? Gd : Utils::spjoin_cols(*this, Gd);
+  }
+}
+
+sp_mat Gradient::assemble(const sp_mat &Gx, const sp_mat &Gy) {
+  u32 m = Gx.n_rows - 1, n = Gy.n_rows - 1;
+
   sp_mat Im = speye(m + 2, m + 2);
   sp_mat In = speye(n + 2, n + 2);
 
@@ -254,20 +271,17 @@ Gradient::Gradient(u16 k, u32 m, u32 n, Real dx, Real dy) {
 
   // Dimensions = 2*m*n+m+n, (m+2)*(n+2)
   if (m != n)
-    *this = Utils::spjoin_cols(G1, G2);
-  else {
-    sp_mat A1(2, 1);
-    sp_mat A2(2, 1);
-    A1(0, 0) = A2(1, 0) = 1.0;
-    *this = Utils::spkron(A1, G1) + Utils::spkron(A2, G2);
-  }
+    return Utils::spjoin_cols(G1, G2);
+
+  sp_mat A1(2, 1);
+  sp_mat A2(2, 1);
+  A1(0, 0) = A2(1, 0) = 1.0;
+  return Utils::spkron(A1, G1) + Utils::spkron(A2, G2);
 }
 
-// 3-D Constructor
-Gradient::Gradient(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz) {
-  Gradient Gx(k, m, dx);
-  Gradient Gy(k, n, dy);
-  Gradient Gz(k, o, dz);
+sp_mat Gradient::assemble(const sp_mat &Gx, const sp_mat &Gy,
+                          const sp_mat &Gz) {
+  u32 m = Gx.n_rows - 1, n = Gy.n_rows - 1, o = Gz.n_rows - 1;
 
   sp_mat Im = speye(m + 2, m + 2);
   sp_mat In = speye(n + 2, n + 2);
@@ -286,16 +300,20 @@ Gradient::Gradient(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz) {
 
   // Dimensions = 3*m*n*o+m*n+m*o+n*o, (m+2)*(n+2)*(o+2)
   if ((m != n) || (n != o))
-    *this = Utils::spjoin_cols(Utils::spjoin_cols(G1, G2), G3);
-  else {
-    sp_mat A1(3, 1);
-    sp_mat A2(3, 1);
-    sp_mat A3(3, 1);
-    A1(0, 0) = A2(1, 0) = A3(2, 0) = 1.0;
-    *this =
-        Utils::spkron(A1, G1) + Utils::spkron(A2, G2) + Utils::spkron(A3, G3);
-  }
+    return Utils::spjoin_cols(Utils::spjoin_cols(G1, G2), G3);
+
+  sp_mat A1(3, 1);
+  sp_mat A2(3, 1);
+  sp_mat A3(3, 1);
+  A1(0, 0) = A2(1, 0) = A3(2, 0) = 1.0;
+  return Utils::spkron(A1, G1) + Utils::spkron(A2, G2) + Utils::spkron(A3, G3);
 }
 
 // Returns weights
 vec Gradient::getP() { return P; }
+
+// Returns the metric of an axis
+vec Gradient::getJ(u16 axis) {
+  assert(axis < J.size());
+  return J[axis];
+}
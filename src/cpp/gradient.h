@@ -17,8 +17,10 @@
 #ifndef GRADIENT_H
 #define GRADIENT_H
 
+#include "jacobian.h"
 #include "utils.h"
 #include <cassert>
+#include <vector>
 
 /**
  * @brief Mimetic Gradient operator
@@ -62,6 +64,45 @@ public:
    */  
   Gradient(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz);
 
+  /**
+   * @brief 1-D Non-uniform Mimetic Gradient Constructor
+   *
+   * @param k Order of accuracy
+   * @param ticks Centers' ticks including the boundaries, m + 2 values
+   *
+   * @note getP() returns the weights of the unit-spaced operator, the
+   * widths of the cells enter through getJ().
+   */
+  Gradient(u16 k, const vec &ticks);
+
+  /**
+   * @brief 2-D Non-uniform Mimetic Gradient Constructor
+   *
+   * @param k Order of accuracy
+   * @param xticks Centers' ticks in x-direction, with the boundaries
+   * @param yticks Centers' ticks in y-direction, with the boundaries
+   */
+  Gradient(u16 k, const vec &xticks, const vec &yticks);
+
+  /**
+   * @brief 3-D Non-uniform Mimetic Gradient Constructor
+   *
+   * @param k Order of accuracy
+   * @param xticks Centers' ticks in x-direction, with the boundaries
+   * @param yticks Centers' ticks in y-direction, with the boundaries
+   * @param zticks Centers' ticks in z-direction, with the boundaries
+   */
+  Gradient(u16 k, const vec &xticks, const vec &yticks, const vec &zticks);
+
+  /**
+   * @brief 2-D or 3-D Curvilinear Mimetic Gradient Constructor, as in
+   * grad2DCurv.m and grad3DCurv.m
+   *
+   * @param k Order of accuracy
+   * @param jacobian Metrics of the grid
+   */
+  Gradient(u16 k, const Jacobian &jacobian);
+
 
   /**
    * @brief Returns the weights used in the Mimeitc Gradient Operators.
@@ -70,7 +111,21 @@ public:
    */  
   vec getP();
 
+  /**
+   * @brief Returns the metric of an axis, 1 / (G ticks) at the faces
+   *
+   * @note computed once at construction, 1 / dx for uniform operators.
+   * Not available for curvilinear operators.
+   */
+  vec getJ(u16 axis = 0);
+
 private:
+  // 1-D operators joined into a 2-D or 3-D one
+  static sp_mat assemble(const sp_mat &Gx, const sp_mat &Gy);
+  static sp_mat assemble(const sp_mat &Gx, const sp_mat &Gy,
+                         const sp_mat &Gz);
+
+  std::vector<vec> J;
   vec P;
 };
 
@@ -0,0 +1,106 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file grid.cpp
+ *
+ * @brief Staggered grids and non-owning field views
+ *
+ * @date 2026/10/19
+ */
+
+#include "grid.h"
+#include <cassert>
+
+// Boundary nodes and cell centers of m cells between a and b
+static vec nodes(u32 m, Real a, Real b) {
+  Real h = (b - a) / m;
+  vec x(m + 2);
+
+  x(0) = a;
+  x(m + 1) = b;
+  for (u32 i = 1; i <= m; ++i)
+    x(i) = a + (i - 0.5) * h;
+
+  return x;
+}
+
+Grid1D::Grid1D(u32 m, Real west, Real east)
+    : m(m), west(west), east(east), dx((east - west) / m) {}
+
+vec Grid1D::xc() const { return nodes(m, west, east); }
+
+vec Grid1D::xf() const { return linspace(west, east, m + 1); }
+
+Field Grid1D::centers(vec &u) const {
+  assert(u.n_elem == n_centers());
+  return Field(u.memptr(), m + 2);
+}
+
+Field Grid1D::faces(vec &v) const {
+  assert(v.n_elem == n_faces());
+  return Field(v.memptr(), m + 1);
+}
+
+Grid2D::Grid2D(u32 m, u32 n, Real west, Real east, Real south, Real north)
+    : m(m), n(n), west(west), east(east), dx((east - west) / m), south(south),
+      north(north), dy((north - south) / n) {}
+
+vec Grid2D::xc() const { return nodes(m, west, east); }
+
+vec Grid2D::yc() const { return nodes(n, south, north); }
+
+vec Grid2D::xf() const { return linspace(west, east, m + 1); }
+
+vec Grid2D::yf() const { return linspace(south, north, n + 1); }
+
+Field Grid2D::centers(vec &u) const {
+  assert(u.n_elem == n_centers());
+  return Field(u.memptr(), m + 2, n + 2);
+}
+
+Field Grid2D::faces(vec &v, u16 axis) const {
+  assert(v.n_elem == n_faces() && axis < 2);
+
+  if (axis == 0)
+    return Field(v.memptr(), m + 1, n);
+  return Field(v.memptr() + uword(m + 1) * n, m, n + 1);
+}
+
+Grid3D::Grid3D(u32 m, u32 n, u32 o, Real west, Real east, Real south,
+               Real north, Real bottom, Real top)
+    : m(m), n(n), o(o), west(west), east(east), dx((east - west) / m),
+      south(south), north(north), dy((north - south) / n), bottom(bottom),
+      top(top), dz((top - bottom) / o) {}
+
+vec Grid3D::xc() const { return nodes(m, west, east); }
+
+vec Grid3D::yc() const { return nodes(n, south, north); }
+
+vec Grid3D::zc() const { return nodes(o, bottom, top); }
+
+vec Grid3D::xf() const { return linspace(west, east, m + 1); }
+
+vec Grid3D::yf() const { return linspace(south, north, n + 1); }
+
+vec Grid3D::zf() const { return linspace(bottom, top, o + 1); }
+
+Field Grid3D::centers(vec &u) const {
+  assert(u.n_elem == n_centers());
+  return Field(u.memptr(), m + 2, n + 2, o + 2);
+}
+
+Field Grid3D::faces(vec &v, u16 axis) const {
+  assert(v.n_elem == n_faces() && axis < 3);
+
+  uword x = uword(m + 1) * n * o, y = uword(m) * (n + 1) * o;
+
+  if (axis == 0)
+    return Field(v.memptr(), m + 1, n, o);
+  if (axis == 1)
+    return Field(v.memptr() + x, m, n + 1, o);
+  return Field(v.memptr() + x + y, m, n, o + 1);
+}
@@ -0,0 +1,295 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file grid.h
+ *
+ * @brief Staggered grids and non-owning field views
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef GRID_H
+#define GRID_H
+
+#include "utils.h"
+
+/**
+ * @brief Non-owning view of a block of a contiguous vector as a 1-D, 2-D or
+ * 3-D array, with the first index fastest
+ *
+ * The view aliases the storage it was made from: writes through it are
+ * writes to the vector, and as_vec(), as_mat() and as_cube() return
+ * Armadillo objects over the same memory, so a field can be handed to an
+ * operator or reshaped without copies. A view must not outlive its storage;
+ * resizing the vector or assigning a temporary to it (which may move in new
+ * memory) invalidates its views.
+ */
+class Field {
+public:
+  /**
+   * @brief View of n_rows x n_cols x n_slices values starting at data
+   */
+  Field(Real *data, uword n_rows, uword n_cols = 1, uword n_slices = 1)
+      : n_rows(n_rows), n_cols(n_cols), n_slices(n_slices), data(data) {}
+
+  /**
+   * @brief Element (i, j, l)
+   */
+  Real &operator()(uword i, uword j = 0, uword l = 0) const {
+    return data[i + n_rows * (j + n_cols * l)];
+  }
+
+  /**
+   * @brief Number of values
+   */
+  uword size() const { return n_rows * n_cols * n_slices; }
+
+  /**
+   * @brief Pointer to the first value
+   */
+  Real *memptr() const { return data; }
+
+  /**
+   * @brief The values as a vec, aliasing the storage
+   */
+  vec as_vec() const { return vec(data, size(), false, true); }
+
+  /**
+   * @brief The values as an n_rows x (n_cols * n_slices) mat, aliasing the
+   * storage
+   */
+  mat as_mat() const { return mat(data, n_rows, n_cols * n_slices, false, true); }
+
+  /**
+   * @brief The values as a cube, aliasing the storage
+   */
+  cube as_cube() const {
+    return cube(data, n_rows, n_cols, n_slices, false, true);
+  }
+
+  const uword n_rows, n_cols, n_slices; ///< Dimensions of the view
+
+private:
+  Real *data;
+};
+
+/**
+ * @brief Uniform 1-D staggered grid of m cells
+ *
+ * Scalars live on the m cell centers plus the two boundary nodes, vectors
+ * on the m + 1 faces, as used by Gradient, Divergence and Laplacian.
+ */
+class Grid1D {
+public:
+  /**
+   * @brief Grid1D constructor
+   *
+   * @param m Number of cells
+   * @param west Left boundary
+   * @param east Right boundary
+   */
+  Grid1D(u32 m, Real west, Real east);
+
+  /**
+   * @brief Number of scalar unknowns, m + 2
+   */
+  uword n_centers() const { return m + 2; }
+
+  /**
+   * @brief Number of vector unknowns, m + 1
+   */
+  uword n_faces() const { return m + 1; }
+
+  /**
+   * @brief Coordinates of the centers and boundary nodes
+   */
+  vec xc() const;
+
+  /**
+   * @brief Coordinates of the faces
+   */
+  vec xf() const;
+
+  /**
+   * @brief View of a scalar vector of n_centers() values
+   */
+  Field centers(vec &u) const;
+
+  /**
+   * @brief View of a vector field of n_faces() values
+   */
+  Field faces(vec &v) const;
+
+  const u32 m;                ///< Number of cells
+  const Real west, east, dx;  ///< Bounds and cell width
+};
+
+/**
+ * @brief Uniform 2-D staggered grid of m x n cells
+ *
+ * Scalar node (i, j), 0 <= i <= m + 1 and 0 <= j <= n + 1, is entry
+ * i + (m + 2) j. Vectors hold the (m + 1) x n x-faces followed by the
+ * m x (n + 1) y-faces, each with i fastest, as produced by Gradient.
+ */
+class Grid2D {
+public:
+  /**
+   * @brief Grid2D constructor
+   *
+   * @param m Number of cells in x-direction
+   * @param n Number of cells in y-direction
+   * @param west, east Bounds in x-direction
+   * @param south, north Bounds in y-direction
+   */
+  Grid2D(u32 m, u32 n, Real west, Real east, Real south, Real north);
+
+  /**
+   * @brief Number of scalar unknowns, (m + 2)(n + 2)
+   */
+  uword n_centers() const { return uword(m + 2) * (n + 2); }
+
+  /**
+   * @brief Number of vector unknowns, 2mn + m + n
+   */
+  uword n_faces() const { return 2 * uword(m) * n + m + n; }
+
+  /**
+   * @brief Index of scalar node (i, j)
+   */
+  uword index(u32 i, u32 j) const { return i + uword(m + 2) * j; }
+
+  /**
+   * @brief Coordinates of the centers and boundary nodes along each axis
+   */
+  vec xc() const;
+  vec yc() const;
+
+  /**
+   * @brief Coordinates of the faces along each axis
+   */
+  vec xf() const;
+  vec yf() const;
+
+  /**
+   * @brief View of a scalar vector as an (m + 2) x (n + 2) array
+   */
+  Field centers(vec &u) const;
+
+  /**
+   * @brief View of one component of a vector field
+   *
+   * @param v vector field of n_faces() values
+   * @param axis 0 for the x-faces, 1 for the y-faces
+   */
+  Field faces(vec &v, u16 axis) const;
+
+  const u32 m, n;                   ///< Number of cells
+  const Real west, east, dx;        ///< x bounds and cell width
+  const Real south, north, dy;      ///< y bounds and cell width
+};
+
+/**
+ * @brief Uniform 3-D staggered grid of m x n x o cells
+ *
+ * Scalar node (i, j, l) is entry i + (m + 2)(j + (n + 2) l). Vectors hold
+ * the (m + 1) n o x-faces, the m (n + 1) o y-faces and the m n (o + 1)
+ * z-faces, each with i fastest, as produced by Gradient.
+ */
+class Grid3D {
+public:
+  /**
+   * @brief Grid3D constructor
+   *
+   * @param m Number of cells in x-direction
+   * @param n Number of cells in y-direction
+   * @param o Number of cells in z-direction
+   * @param west, east Bounds in x-direction
+   * @param south, north Bounds in y-direction
+   * @param bottom, top Bounds in z-direction
+   */
+  Grid3D(u32 m, u32 n, u32 o, Real west, Real east, Real south, Real north,
+         Real bottom, Real top);
+
+  /**
+   * @brief Number of scalar unknowns, (m + 2)(n + 2)(o + 2)
+   */
+  uword n_centers() const { return uword(m + 2) * (n + 2) * (o + 2); }
+
+  /**
+   * @brief Number of vector unknowns, 3mno + mn + mo + no
+   */
+  uword n_faces() const {
+    return 3 * uword(m) * n * o + uword(m) * n + uword(m) * o + uword(n) * o;
+  }
+
+  /**
+   * @brief Index of scalar node (i, j, l)
+   */
+  uword index(u32 i, u32 j, u32 l) const {
+    return i + uword(m + 2) * (j + uword(n + 2) * l);
+  }
+
+  /**
+   * @brief Coordinates of the centers and boundary nodes along each axis
+   */
+  vec xc() const;
+  vec yc() const;
+  vec zc() const;
+
+  /**
+   * @brief Coordinates of the faces along each axis
+   */
+  vec xf() const;
+  vec yf() const;
+  vec zf() const;
+
+  /**
+   * @brief View of a scalar vector as an (m + 2) x (n + 2) x (o + 2) array
+   */
+  Field centers(vec &u) const;
+
+  /**
+   * @brief View of one component of a vector field
+   *
+   * @param v vector field of n_faces() values
+   * @param axis 0, 1 or 2 for the x-, y- or z-faces
+   */
+  Field faces(vec &v, u16 axis) const;
+
+  const u32 m, n, o;                ///< Number of cells
+  const Real west, east, dx;        ///< x bounds and cell width
+  const Real south, north, dy;      ///< y bounds and cell width
+  const Real bottom, top, dz;       ///< z bounds and cell width
+};
+
+/**
+ * @brief Vector field on the faces of a Grid2D or Grid3D, owning its
+ * storage
+ *
+ * values holds the components back to back in the row order of Gradient,
+ * which is the column order of Divergence, so G * p can be assigned to it
+ * and D * values applied to it without reordering. component() is the
+ * (i, j[, l]) view of one component, taken afresh from values each call.
+ */
+template <typename Grid> class FaceField {
+public:
+  /**
+   * @brief Zero field on the faces of grid
+   */
+  explicit FaceField(const Grid &grid)
+      : grid(grid), values(grid.n_faces(), fill::zeros) {}
+
+  /**
+   * @brief View of the x-, y- or z-component
+   */
+  Field component(u16 axis) { return grid.faces(values, axis); }
+
+  const Grid grid;  ///< Grid of the field
+  vec values;       ///< All faces, as the rows of Gradient
+};
+
+#endif // GRID_H
@@ -0,0 +1,89 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file imexintegrator.h
+ *
+ * @brief Implicit-explicit and split integrators for advection-diffusion
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef IMEXINTEGRATOR_H
+#define IMEXINTEGRATOR_H
+
+#include "implicitintegrator.h"
+
+/**
+ * @brief Integrators for du/dt = Lu + E(t, u), L stiff and linear
+ *
+ * L is typically the diffusion D*K*G and E the advection -D*(V % (I*u)).
+ * L is treated implicitly through a step matrix I - c*dt*L factorised once
+ * per dt, and E explicitly, so dt is limited by the advective CFL condition
+ * only.
+ *
+ * - IMEX_EULER: forward/backward Euler, first order
+ * - ARS222:     Ascher-Ruuth-Spiteri (2,2,2) IMEX Runge-Kutta, second order,
+ *               L-stable implicit part, two solves per step
+ * - STRANG:     E(dt/2) L(dt) E(dt/2), half steps of SSP-RK2 around a
+ *               Crank-Nicolson step, second order
+ */
+class ImexIntegrator {
+public:
+  /**
+   * @brief Available methods
+   */
+  enum Method { IMEX_EULER, ARS222, STRANG };
+
+  /**
+   * @brief ImexIntegrator constructor, factorises the step matrix
+   *
+   * @param L a square sparse operator, treated implicitly
+   * @param E right hand side treated explicitly
+   * @param dt time step
+   * @param method IMEX scheme
+   * @param backend LinearSolver backend for the step matrix
+   */
+  ImexIntegrator(const sp_mat &L, const Integrator::RHS &E, Real dt,
+                 Method method = ARS222,
+                 const std::string &backend = LinearSolver::default_backend());
+
+  /**
+   * @brief Changes the time step, refactorises the step matrix
+   */
+  void set_dt(Real dt);
+
+  /**
+   * @brief Time step
+   */
+  Real dt() const { return h; }
+
+  /**
+   * @brief Advances u in place from t to t + dt
+   */
+  void step(Real t, vec &u);
+
+  /**
+   * @brief Takes a number of steps from t0
+   *
+   * @return final time
+   */
+  Real integrate(Real t0, u32 steps, vec &u);
+
+private:
+  sp_mat L;
+  Integrator::RHS E;
+  Real h;
+  Method method;
+  std::string backend;
+  Integrator::RHS apply;                         // u -> Lu
+  std::unique_ptr<LinearSolver> factor;          // IMEX_EULER, ARS222
+  std::unique_ptr<ImplicitIntegrator> diffusion; // STRANG
+  Integrator advection;                          // STRANG
+  vec e1, e2, l2, rhs;                           // Stage buffers
+};
+
+#endif // IMEXINTEGRATOR_H
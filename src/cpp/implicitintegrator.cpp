@@ -0,0 +1,105 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file implicitintegrator.cpp
+ *
+ * @brief Implicit time integrators with a reused factorization
+ *
+ * @date 2026/10/19
+ */
+
+#include "implicitintegrator.h"
+#include <cassert>
+
+ImplicitIntegrator::ImplicitIntegrator(const sp_mat &L, Real dt, Method method,
+                                       Real theta, const std::string &backend)
+    : L(L), method(method), theta(theta), backend(backend) {
+  assert(L.n_rows == L.n_cols);
+  assert(theta >= 0 && theta <= 1);
+
+  apply = Integrator::linear(L);
+  factor = LinearSolver::create(backend);
+  set_dt(dt);
+}
+
+sp_mat ImplicitIntegrator::shifted(Real c) const {
+  return speye(L.n_rows, L.n_cols) - c * L;
+}
+
+void ImplicitIntegrator::set_dt(Real dt) {
+  assert(dt > 0);
+
+  h = dt;
+  factor->factorise(shifted(method == BDF2 ? 2.0 / 3 * dt : theta * dt));
+
+  // BDF2 assumes a constant step
+  started = false;
+}
+
+void ImplicitIntegrator::step(Real t, vec &u) {
+  uword N = u.n_elem;
+  assert(N == L.n_rows);
+
+  if (rhs.n_elem != N) {
+    Lu.set_size(N);
+    rhs.set_size(N);
+  }
+  // The source may be set after the first step
+  if (source && g.n_elem != N)
+    g.set_size(N);
+
+  if (method == THETA) {
+    // (I - theta dt L) u+ = u + (1 - theta) dt (Lu + g(t)) + theta dt g(t+dt)
+    apply(t, u, Lu);
+    rhs = u + ((1 - theta) * h) * Lu;
+
+    if (source) {
+      source(t, g);
+      rhs += ((1 - theta) * h) * g;
+      source(t + h, g);
+      rhs += (theta * h) * g;
+    }
+
+    u = factor->solve(rhs);
+    return;
+  }
+
+  if (!started) {
+    // Backward Euler start, its own factorization is used only once
+    rhs = u;
+    if (source) {
+      source(t + h, g);
+      rhs += h * g;
+    }
+
+    previous = u;
+    u = LinearSolver::spsolve(shifted(h), rhs, backend);
+    started = true;
+    return;
+  }
+
+  // (I - 2/3 dt L) u+ = 4/3 u - 1/3 u- + 2/3 dt g(t+dt)
+  rhs = (4.0 / 3) * u - (1.0 / 3) * previous;
+  if (source) {
+    source(t + h, g);
+    rhs += (2.0 / 3 * h) * g;
+  }
+
+  previous = u;
+  u = factor->solve(rhs);
+}
+
+Real ImplicitIntegrator::integrate(Real t0, u32 steps, vec &u) {
+  Real t = t0;
+
+  for (u32 s = 0; s < steps; ++s) {
+    step(t, u);
+    t = t0 + (s + 1) * h;
+  }
+
+  return t;
+}
@@ -0,0 +1,115 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file implicitintegrator.h
+ *
+ * @brief Implicit time integrators with a reused factorization
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef IMPLICITINTEGRATOR_H
+#define IMPLICITINTEGRATOR_H
+
+#include "integrator.h"
+#include "solver.h"
+
+/**
+ * @brief Implicit integrators for du/dt = Lu + g(t)
+ *
+ * L is a mimetic operator with its boundary rows, e.g. a Laplacian (whose
+ * zero boundary rows keep Dirichlet values fixed) or D*K*G. The step matrix
+ *
+ * - THETA: I - theta*dt*L, theta = 1/2 is Crank-Nicolson, 1 backward Euler
+ * - BDF2:  I - 2/3*dt*L
+ *
+ * is factorised once per dt and reused every step, so a step costs one
+ * product with L and one solve. Time steps are not bound by the explicit
+ * stability limit dt ~ dx^2.
+ */
+class ImplicitIntegrator {
+public:
+  /**
+   * @brief Source callback, writes g(t) into the preallocated g
+   */
+  using Source = std::function<void(Real t, vec &g)>;
+
+  /**
+   * @brief Available methods
+   */
+  enum Method {
+    THETA, ///< One-step theta method
+    BDF2   ///< Two-step backward differentiation, started by backward Euler
+  };
+
+  /**
+   * @brief ImplicitIntegrator constructor, factorises the step matrix
+   *
+   * @param L a square sparse operator
+   * @param dt time step
+   * @param method THETA or BDF2
+   * @param theta implicitness of THETA, in [0, 1]
+   * @param backend LinearSolver backend for the step matrix
+   */
+  ImplicitIntegrator(const sp_mat &L, Real dt, Method method = THETA,
+                     Real theta = 0.5,
+                     const std::string &backend = LinearSolver::default_backend());
+
+  /**
+   * @brief Adds a source term g(t), none by default
+   */
+  void set_source(const Source &g) { source = g; }
+
+  /**
+   * @brief Changes the time step, refactorises the step matrix
+   */
+  void set_dt(Real dt);
+
+  /**
+   * @brief Time step
+   */
+  Real dt() const { return h; }
+
+  /**
+   * @brief Advances u in place from t to t + dt
+   */
+  void step(Real t, vec &u);
+
+  /**
+   * @brief Takes a number of steps from t0
+   *
+   * @return final time
+   */
+  Real integrate(Real t0, u32 steps, vec &u);
+
+  /**
+   * @brief Forgets the BDF2 history, needed if u is changed between steps
+   */
+  void reset() { started = false; }
+
+  /**
+   * @brief Timings and fill of the step matrix factorization
+   */
+  const SolverStats &stats() const { return factor->stats(); }
+
+private:
+  // I - c*L
+  sp_mat shifted(Real c) const;
+
+  sp_mat L;
+  Real h;
+  Method method;
+  Real theta;
+  std::string backend;
+  Integrator::RHS apply;   // u -> Lu, allocation-free
+  Source source;
+  std::unique_ptr<LinearSolver> factor;
+  bool started = false;    // True if previous holds the last BDF2 step
+  vec Lu, g, rhs, previous;
+};
+
+#endif // IMPLICITINTEGRATOR_H
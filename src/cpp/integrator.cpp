@@ -0,0 +1,158 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file integrator.cpp
+ *
+ * @brief Explicit time integrators for semi-discrete mimetic systems
+ *
+ * @date 2026/10/19
+ */
+
+#include "integrator.h"
+#include "numa.h"
+#include <algorithm>
+#include <memory>
+
+// y = a*y + b*x + c*z in a single pass
+static void combine(vec &y, Real a, Real b, const vec &x, Real c,
+                    const vec &z) {
+  Real *py = y.memptr();
+  const Real *px = x.memptr();
+  const Real *pz = z.memptr();
+  const uword N = y.n_elem;
+
+#pragma omp simd
+  for (uword i = 0; i < N; ++i)
+    py[i] = a * py[i] + b * px[i] + c * pz[i];
+}
+
+Integrator::Integrator(Method method, const RHS &f) : method(method), f(f) {}
+
+u16 Integrator::order() const {
+  switch (method) {
+  case EULER:
+    return 1;
+  case SSPRK2:
+    return 2;
+  case SSPRK3:
+    return 3;
+  default:
+    return 4;
+  }
+}
+
+void Integrator::step(Real t, Real dt, vec &u) {
+  uword N = u.n_elem;
+
+  // Only the first step (or a change of size) allocates
+  if (k1.n_elem != N) {
+    k1.set_size(N);
+    w.set_size(N);
+    if (method != EULER)
+      k2.set_size(N);
+    if (method == SSPRK3 || method == RK4)
+      k3.set_size(N);
+    if (method == RK4)
+      k4.set_size(N);
+  }
+
+  f(t, u, k1);
+
+  switch (method) {
+  case EULER:
+    u += dt * k1;
+    break;
+
+  case SSPRK2:
+    w = u + dt * k1;
+    f(t + dt, w, k2);
+    combine(u, 0.5, 0.5, w, 0.5 * dt, k2);
+    break;
+
+  case SSPRK3:
+    w = u + dt * k1;
+    f(t + dt, w, k2);
+    combine(w, 0.25, 0.75, u, 0.25 * dt, k2);
+    f(t + 0.5 * dt, w, k3);
+    combine(u, 1.0 / 3, 2.0 / 3, w, 2.0 / 3 * dt, k3);
+    break;
+
+  case RK4:
+    w = u + (0.5 * dt) * k1;
+    f(t + 0.5 * dt, w, k2);
+    w = u + (0.5 * dt) * k2;
+    f(t + 0.5 * dt, w, k3);
+    w = u + dt * k3;
+    f(t + dt, w, k4);
+    u += (dt / 6) * (k1 + 2 * k2 + 2 * k3 + k4);
+    break;
+  }
+}
+
+u32 Integrator::integrate(Real t0, Real tf, Real dt, vec &u) {
+  u32 steps = 0;
+  Real t = t0;
+
+  while (tf - t > 1e-12 * dt) {
+    Real h = std::min(dt, tf - t);
+    step(t, h, u);
+    t += h;
+    ++steps;
+  }
+
+  return steps;
+}
+
+Integrator::RHS Integrator::linear(const sp_mat &A) {
+  // Stored by rows and placed by the threads that compute them, shared so
+  // the callback stays copyable
+  auto M = std::make_shared<const NumaMatrix>(A);
+
+  return [M](Real, const vec &u, vec &du) { M->apply(u, du); };
+}
+
+Verlet::Verlet(Method method, const Force &F) : method(method), F(F) {}
+
+void Verlet::step(Real t, Real dt, vec &u, vec &v) {
+  if (a.n_elem != u.n_elem) {
+    a.set_size(u.n_elem);
+    cached = false;
+  }
+
+  switch (method) {
+  case VELOCITY:
+    if (!cached)
+      F(t, u, a);
+    v += (0.5 * dt) * a;
+    u += dt * v;
+    F(t + dt, u, a);
+    v += (0.5 * dt) * a;
+    cached = true;
+    break;
+
+  case POSITION:
+    u += (0.5 * dt) * v;
+    F(t + 0.5 * dt, u, a);
+    v += dt * a;
+    u += (0.5 * dt) * v;
+    break;
+  }
+}
+
+u32 Verlet::integrate(Real t0, Real tf, Real dt, vec &u, vec &v) {
+  u32 steps = 0;
+  Real t = t0;
+
+  while (tf - t > 1e-12 * dt) {
+    Real h = std::min(dt, tf - t);
+    step(t, h, u, v);
+    t += h;
+    ++steps;
+  }
+
+  return steps;
+}
@@ -0,0 +1,137 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file integrator.h
+ *
+ * @brief Explicit time integrators for semi-discrete mimetic systems
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef INTEGRATOR_H
+#define INTEGRATOR_H
+
+#include "utils.h"
+#include <functional>
+
+/**
+ * @brief Explicit Runge-Kutta integrators for du/dt = f(t, u)
+ *
+ * Stage vectors are allocated on the first step and reused afterwards, and
+ * the stage updates are fused into single passes, so stepping does no heap
+ * allocation as long as f does not allocate either (see linear()).
+ */
+class Integrator {
+public:
+  /**
+   * @brief Right hand side callback, writes f(t, u) into the preallocated du
+   */
+  using RHS = std::function<void(Real t, const vec &u, vec &du)>;
+
+  /**
+   * @brief Available methods
+   */
+  enum Method {
+    EULER,  ///< Forward Euler, first order
+    SSPRK2, ///< Strong stability preserving RK (Heun), second order
+    SSPRK3, ///< Strong stability preserving RK (Shu-Osher), third order
+    RK4     ///< Classical Runge-Kutta, fourth order
+  };
+
+  /**
+   * @brief Integrator constructor
+   *
+   * @param method Runge-Kutta method
+   * @param f right hand side
+   */
+  Integrator(Method method, const RHS &f);
+
+  /**
+   * @brief Advances u in place from t to t + dt
+   */
+  void step(Real t, Real dt, vec &u);
+
+  /**
+   * @brief Advances u in place from t0 to tf, shortening the last step
+   *
+   * @return number of steps taken
+   */
+  u32 integrate(Real t0, Real tf, Real dt, vec &u);
+
+  /**
+   * @brief Order of accuracy of the method
+   */
+  u16 order() const;
+
+  /**
+   * @brief Allocation-free right hand side f(t, u) = Au
+   *
+   * @param A a sparse operator, e.g. a Laplacian, copied into a NumaMatrix
+   * held by the callback
+   */
+  static RHS linear(const sp_mat &A);
+
+private:
+  Method method;
+  RHS f;
+  vec k1, k2, k3, k4, w; // Stage buffers
+};
+
+/**
+ * @brief Verlet integrators for u'' = F(t, u), with v = u'
+ *
+ * Both methods are second order and symplectic. Velocity Verlet reuses the
+ * force of the previous step, so it costs one evaluation of F per step.
+ */
+class Verlet {
+public:
+  /**
+   * @brief Force callback, writes F(t, u) into the preallocated a
+   */
+  using Force = Integrator::RHS;
+
+  /**
+   * @brief Available methods
+   */
+  enum Method {
+    VELOCITY, ///< Kick-drift-kick
+    POSITION  ///< Drift-kick-drift
+  };
+
+  /**
+   * @brief Verlet constructor
+   *
+   * @param method Verlet variant
+   * @param F force, i.e. acceleration
+   */
+  Verlet(Method method, const Force &F);
+
+  /**
+   * @brief Advances u and v in place from t to t + dt
+   */
+  void step(Real t, Real dt, vec &u, vec &v);
+
+  /**
+   * @brief Advances u and v in place from t0 to tf, shortening the last step
+   *
+   * @return number of steps taken
+   */
+  u32 integrate(Real t0, Real tf, Real dt, vec &u, vec &v);
+
+  /**
+   * @brief Discards the cached force, needed if u is changed between steps
+   */
+  void reset() { cached = false; }
+
+private:
+  Method method;
+  Force F;
+  vec a;               // Force at the current u
+  bool cached = false; // True if a is up to date (velocity Verlet)
+};
+
+#endif // INTEGRATOR_H
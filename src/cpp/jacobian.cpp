@@ -0,0 +1,202 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file jacobian.cpp
+ *
+ * @brief Metrics of 2-D and 3-D curvilinear grids
+ *
+ * @date 2026/10/19
+ */
+
+#include "jacobian.h"
+#include "nodal.h"
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+namespace {
+
+// c + 1 node or face values to the c cells between them
+sp_mat average(u32 c) {
+  sp_mat A(c, c + 1);
+  for (u32 i = 0; i < c; ++i)
+    A(i, i) = A(i, i + 1) = 0.5;
+  return A;
+}
+
+// c cell values to the c + 1 faces, linearly extrapolated at the ends
+sp_mat extrapolate(u32 c) {
+  sp_mat A(c + 1, c);
+  for (u32 i = 1; i < c; ++i)
+    A(i, i - 1) = A(i, i) = 0.5;
+  A(0, 0) = A(c, c - 1) = 1.5;
+  A(0, 1) = A(c, c - 2) = -0.5;
+  return A;
+}
+
+// c + 1 node values to the c centers and the two boundary nodes
+sp_mat centers(u32 c) {
+  sp_mat A(c + 2, c + 1);
+  A(0, 0) = A(c + 1, c) = 1;
+  for (u32 i = 1; i <= c; ++i)
+    A(i, i - 1) = A(i, i) = 0.5;
+  return A;
+}
+
+// c + 1 face values to the c centers, boundary rows empty
+sp_mat interior_average(u32 c) {
+  sp_mat A(c + 2, c + 1);
+  for (u32 i = 1; i <= c; ++i)
+    A(i, i - 1) = A(i, i) = 0.5;
+  return A;
+}
+
+// c cell values to the c centers, boundary rows empty
+sp_mat interior(u32 c) {
+  sp_mat A(c + 2, c);
+  for (u32 i = 1; i <= c; ++i)
+    A(i, i - 1) = 1;
+  return A;
+}
+
+// Derivative of c cell values at the c centers: central, one-sided at the
+// first and last cell, boundary rows empty
+sp_mat difference(u32 c) {
+  sp_mat A(c + 2, c);
+  for (u32 i = 1; i <= c; ++i) {
+    u32 lo = i > 1 ? i - 2 : 0, hi = std::min(i, c - 1);
+    A(i, lo) -= 1.0 / (hi - lo);
+    A(i, hi) += 1.0 / (hi - lo);
+  }
+  return A;
+}
+
+} // namespace
+
+Jacobian::Jacobian(u16 k, const mat &X, const mat &Y) {
+  assert(X.n_rows == Y.n_rows && X.n_cols == Y.n_cols);
+  cells = {(u32)X.n_cols - 1, (u32)X.n_rows - 1};
+
+  // Node values, i fastest
+  vec x = vectorise(X.t()), y = vectorise(Y.t());
+
+  differentiate(k, x, Xe, Xn, Xc);
+  differentiate(k, y, Ye, Yn, Yc);
+
+  J = Xe % Yn - Xn % Ye;
+  C = {Yn, -Ye, -Xn, Xe};
+
+  if (J.min() * J.max() <= 0)
+    throw std::invalid_argument("Jacobian: folded or degenerate grid");
+}
+
+Jacobian::Jacobian(u16 k, const cube &X, const cube &Y, const cube &Z) {
+  assert(X.n_rows == Y.n_rows && X.n_cols == Y.n_cols &&
+         X.n_slices == Y.n_slices);
+  assert(X.n_rows == Z.n_rows && X.n_cols == Z.n_cols &&
+         X.n_slices == Z.n_slices);
+  cells = {(u32)X.n_cols - 1, (u32)X.n_rows - 1, (u32)X.n_slices - 1};
+
+  // Node values, i fastest
+  uword M = X.n_cols, N = X.n_rows, O = X.n_slices;
+  vec x(M * N * O), y(M * N * O), z(M * N * O);
+  for (uword l = 0; l < O; ++l)
+    for (uword j = 0; j < N; ++j)
+      for (uword i = 0; i < M; ++i) {
+        uword id = i + M * (j + N * l);
+        x(id) = X(j, i, l);
+        y(id) = Y(j, i, l);
+        z(id) = Z(j, i, l);
+      }
+
+  differentiate(k, x, Xe, Xn, Xc);
+  differentiate(k, y, Ye, Yn, Yc);
+  differentiate(k, z, Ze, Zn, Zc);
+
+  J = Xe % (Yn % Zc - Yc % Zn) - Ye % (Xn % Zc - Xc % Zn) +
+      Ze % (Xn % Yc - Xc % Yn);
+  C = {Yn % Zc - Zn % Yc, Ze % Yc - Ye % Zc, Ye % Zn - Ze % Yn,
+       Zn % Xc - Xn % Zc, Xe % Zc - Ze % Xc, Ze % Xn - Xe % Zn,
+       Xn % Yc - Yn % Xc, Ye % Xc - Xe % Yc, Xe % Yn - Ye % Xn};
+
+  if (J.min() * J.max() <= 0)
+    throw std::invalid_argument("Jacobian: folded or degenerate grid");
+}
+
+void Jacobian::differentiate(u16 k, const vec &x, vec &xe, vec &xn,
+                             vec &xc) const {
+  if (k % 2 || k < 2 || *std::min_element(cells.begin(), cells.end()) < k)
+    throw std::invalid_argument("Jacobian: need an even k and at least k cells");
+
+  vec *d[3] = {&xe, &xn, &xc};
+  const uword M = cells[0] + 1, N = cells[1] + 1,
+              O = dimension() == 3 ? cells[2] + 1 : 1;
+
+  // Node values as a cube, read in place; derivatives written in place
+  const cube u(const_cast<Real *>(x.memptr()), M, N, O, false, true);
+  for (u16 a = 0; a < dimension(); ++a) {
+    d[a]->set_size(x.n_elem);
+    cube du(d[a]->memptr(), M, N, O, false, true);
+    Nodal::apply(k, u, du, a);
+  }
+}
+
+sp_mat Jacobian::tensor(const std::vector<sp_mat> &T) const {
+  sp_mat result = T[0];
+  for (size_t b = 1; b < T.size(); ++b)
+    result = Utils::spkron(T[b], result);
+  return result;
+}
+
+sp_mat Jacobian::nodes_to(u16 d) const {
+  assert(d <= dimension());
+
+  std::vector<sp_mat> T(dimension());
+  for (u16 b = 0; b < dimension(); ++b) {
+    u32 c = cells[b];
+    if (d == dimension())
+      T[b] = centers(c);
+    else
+      T[b] = b == d ? sp_mat(speye(c + 1, c + 1)) : average(c);
+  }
+
+  return tensor(T);
+}
+
+sp_mat Jacobian::faces_to(u16 a, u16 d) const {
+  assert(a < dimension() && d < dimension() && a != d);
+
+  std::vector<sp_mat> T(dimension());
+  for (u16 b = 0; b < dimension(); ++b) {
+    u32 c = cells[b];
+    if (b == a)
+      T[b] = average(c);
+    else if (b == d)
+      T[b] = extrapolate(c);
+    else
+      T[b] = speye(c, c);
+  }
+
+  return tensor(T);
+}
+
+sp_mat Jacobian::derivative(u16 d, u16 a) const {
+  assert(a < dimension() && d < dimension() && a != d);
+
+  std::vector<sp_mat> T(dimension());
+  for (u16 b = 0; b < dimension(); ++b) {
+    u32 c = cells[b];
+    if (b == d)
+      T[b] = interior_average(c);
+    else if (b == a)
+      T[b] = difference(c);
+    else
+      T[b] = interior(c);
+  }
+
+  return tensor(T);
+}
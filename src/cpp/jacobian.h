@@ -0,0 +1,103 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file jacobian.h
+ *
+ * @brief Metrics of 2-D and 3-D curvilinear grids
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef JACOBIAN_H
+#define JACOBIAN_H
+
+#include "utils.h"
+#include <vector>
+
+/**
+ * @brief Metrics of a body-fitted grid, computed once at its nodes
+ *
+ * The grid is the image of a logical grid with unit spacing: node (i, j)
+ * sits at (X(j, i), Y(j, i)), the layout of meshgrid, and a grid of
+ * (m + 1) x (n + 1) nodes has m x n cells. The derivatives of the
+ * coordinates with respect to the logical coordinates (e, n, c) are taken
+ * with nodal operators of order k, and stored as the determinant J and the
+ * cofactors of the Jacobian matrix, so that
+ *
+ *   du/dx_d = 1/J * sum_a cofactor(d, a) * du/de_a.
+ *
+ * Gradient and Divergence use these to build curvilinear operators; the
+ * metrics are interpolated to faces and centers during assembly and folded
+ * into the operator values.
+ */
+class Jacobian {
+public:
+  /**
+   * @brief 2-D Jacobian, as in jacobian2D.m
+   *
+   * @param k Order of accuracy
+   * @param X x-coordinates of the nodes, (n + 1) x (m + 1)
+   * @param Y y-coordinates of the nodes, (n + 1) x (m + 1)
+   */
+  Jacobian(u16 k, const mat &X, const mat &Y);
+
+  /**
+   * @brief 3-D Jacobian, as in jacobian3D.m
+   *
+   * @param k Order of accuracy
+   * @param X x-coordinates of the nodes, (n + 1) x (m + 1) x (o + 1)
+   * @param Y y-coordinates of the nodes, (n + 1) x (m + 1) x (o + 1)
+   * @param Z z-coordinates of the nodes, (n + 1) x (m + 1) x (o + 1)
+   */
+  Jacobian(u16 k, const cube &X, const cube &Y, const cube &Z);
+
+  /**
+   * @brief Number of dimensions, 2 or 3
+   */
+  u16 dimension() const { return cells.size(); }
+
+  /**
+   * @brief Cofactor (d, a) of the Jacobian matrix at the nodes
+   *
+   * @param d physical direction
+   * @param a logical direction
+   */
+  const vec &cofactor(u16 d, u16 a) const { return C[d * dimension() + a]; }
+
+  /**
+   * @brief Interpolation of node values to the faces normal to axis d, or
+   * to the centers and boundary nodes if d equals the dimension
+   */
+  sp_mat nodes_to(u16 d) const;
+
+  /**
+   * @brief Interpolation of values on the faces normal to axis a to the
+   * faces normal to axis d, extrapolated at the boundary
+   */
+  sp_mat faces_to(u16 a, u16 d) const;
+
+  /**
+   * @brief Derivative along axis a of values on the faces normal to axis
+   * d != a, at the cell centers. Rows of boundary nodes are empty.
+   */
+  sp_mat derivative(u16 d, u16 a) const;
+
+  std::vector<u32> cells;                   ///< Cells per axis, x first
+  vec J;                                    ///< Determinant at the nodes
+  vec Xe, Xn, Xc, Ye, Yn, Yc, Ze, Zn, Zc;   ///< Derivatives at the nodes
+
+private:
+  // Logical derivatives of coordinate values at the nodes
+  void differentiate(u16 k, const vec &x, vec &xe, vec &xn, vec &xc) const;
+
+  // Kronecker product of one 1-D operator per axis, x fastest
+  sp_mat tensor(const std::vector<sp_mat> &T) const;
+
+  std::vector<vec> C;                       // Cofactors, row-major
+};
+
+#endif // JACOBIAN_H
@@ -0,0 +1,279 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file krylov.cpp
+ *
+ * @brief Krylov subspace solvers for mimetic systems
+ *
+ * @date 2026/10/19
+ */
+
+#include "krylov.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace {
+
+// Inner product of the caller, or the Euclidean one
+Real product(const Krylov::Inner &inner, const vec &a, const vec &b) {
+  return inner ? inner(a, b) : dot(a, b);
+}
+
+} // namespace
+
+Krylov::Operator Krylov::op(const sp_mat &A) {
+  return [&A](const vec &x, vec &y) { y = A * x; };
+}
+
+
+Krylov::Operator Krylov::jacobi(const sp_mat &A) {
+  vec d = vec(A.diag());
+  assert(all(d != 0));
+  vec inv_d = 1.0 / d;
+
+  return [inv_d](const vec &x, vec &y) { y = inv_d % x; };
+}
+
+
+KrylovInfo Krylov::cg(const Operator &A, const vec &b, vec &x,
+                      const Operator &M, Real tol, u32 maxit,
+                      const Inner &inner) {
+  KrylovInfo info;
+  uword N = b.n_elem;
+
+  if (maxit == 0)
+    maxit = N;
+
+  if (x.n_elem != N)
+    x.zeros(N);
+
+  Real bnorm = std::sqrt(product(inner, b, b));
+  if (bnorm == 0) {
+    x.zeros();
+    info.converged = true;
+    return info;
+  }
+
+  // Work vectors are allocated once, the loop only updates them in place
+  vec r(N), z(N), p(N), q(N);
+
+  A(x, q);
+  r = b - q;
+
+  if (M)
+    M(r, z);
+  else
+    z = r;
+
+  p = z;
+  Real rz = product(inner, r, z);
+  info.residual = std::sqrt(product(inner, r, r)) / bnorm;
+
+  while (info.residual > tol && info.iterations < maxit) {
+    A(p, q);
+
+    Real alpha = rz / product(inner, p, q);
+    x += alpha * p;
+    r -= alpha * q;
+
+    if (M)
+      M(r, z);
+    else
+      z = r;
+
+    Real rz_new = product(inner, r, z);
+    p = z + (rz_new / rz) * p;
+    rz = rz_new;
+
+    ++info.iterations;
+    info.residual = std::sqrt(product(inner, r, r)) / bnorm;
+  }
+
+  info.converged = info.residual <= tol;
+
+  return info;
+}
+
+
+KrylovInfo Krylov::bicgstab(const Operator &A, const vec &b, vec &x,
+                            const Operator &M, Real tol, u32 maxit) {
+  KrylovInfo info;
+  uword N = b.n_elem;
+
+  if (maxit == 0)
+    maxit = N;
+
+  if (x.n_elem != N)
+    x.zeros(N);
+
+  Real bnorm = norm(b);
+  if (bnorm == 0) {
+    x.zeros();
+    info.converged = true;
+    return info;
+  }
+
+  vec r(N), r0(N), p(N, fill::zeros), v(N, fill::zeros), s(N), t(N), y(N),
+      z(N);
+
+  A(x, t);
+  r = b - t;
+  r0 = r;
+
+  Real rho = 1, alpha = 1, omega = 1;
+  info.residual = norm(r) / bnorm;
+
+  while (info.residual > tol && info.iterations < maxit) {
+    Real rho_new = dot(r0, r);
+    if (rho_new == 0)
+      break; // Breakdown, r is orthogonal to the shadow residual
+
+    p = r + ((rho_new / rho) * (alpha / omega)) * (p - omega * v);
+
+    if (M)
+      M(p, y);
+    else
+      y = p;
+    A(y, v);
+    alpha = rho_new / dot(r0, v);
+    s = r - alpha * v;
+
+    ++info.iterations;
+
+    if (norm(s) / bnorm <= tol) {
+      x += alpha * y;
+      info.residual = norm(s) / bnorm;
+      break;
+    }
+
+    if (M)
+      M(s, z);
+    else
+      z = s;
+    A(z, t);
+    omega = dot(t, s) / dot(t, t);
+
+    x += alpha * y + omega * z;
+    r = s - omega * t;
+    rho = rho_new;
+
+    info.residual = norm(r) / bnorm;
+  }
+
+  info.converged = info.residual <= tol;
+
+  return info;
+}
+
+
+KrylovInfo Krylov::gmres(const Operator &A, const vec &b, vec &x,
+                         const Operator &M, Real tol, u32 maxit, u32 restart,
+                         const Inner &inner) {
+  KrylovInfo info;
+  uword N = b.n_elem;
+
+  if (maxit == 0)
+    maxit = N;
+
+  // Without an inner product hook N is also the size of the whole system
+  restart = std::min(restart, maxit);
+  if (!inner)
+    restart = std::min<uword>(restart, N);
+
+  if (x.n_elem != N)
+    x.zeros(N);
+
+  Real bnorm = std::sqrt(product(inner, b, b));
+  if (bnorm == 0) {
+    x.zeros();
+    info.converged = true;
+    return info;
+  }
+
+  // Arnoldi basis, Hessenberg matrix and Givens rotations of one cycle
+  mat V(N, restart + 1);
+  mat H(restart + 1, restart, fill::zeros);
+  vec cs(restart), sn(restart), g(restart + 1);
+  vec w(N), z(N), vj(N);
+
+  while (true) {
+    A(x, w);
+    vec r = b - w;
+    Real beta = std::sqrt(product(inner, r, r));
+
+    info.residual = beta / bnorm;
+    if (info.residual <= tol || info.iterations >= maxit)
+      break;
+
+    V.col(0) = r / beta;
+    g.zeros();
+    g(0) = beta;
+
+    uword j = 0;
+    while (j < restart && info.iterations < maxit) {
+      vj = V.col(j);
+      if (M)
+        M(vj, z);
+      else
+        z = vj;
+      A(z, w);
+
+      // Modified Gram-Schmidt
+      for (uword i = 0; i <= j; ++i) {
+        const vec vi(V.colptr(i), N, false, true);
+        H(i, j) = product(inner, w, vi);
+        w -= H(i, j) * vi;
+      }
+      H(j + 1, j) = std::sqrt(product(inner, w, w));
+      if (H(j + 1, j) > 0)
+        V.col(j + 1) = w / H(j + 1, j);
+
+      for (uword i = 0; i < j; ++i) {
+        Real h = cs(i) * H(i, j) + sn(i) * H(i + 1, j);
+        H(i + 1, j) = -sn(i) * H(i, j) + cs(i) * H(i + 1, j);
+        H(i, j) = h;
+      }
+
+      Real rr = std::hypot(H(j, j), H(j + 1, j));
+      cs(j) = H(j, j) / rr;
+      sn(j) = H(j + 1, j) / rr;
+      H(j, j) = rr;
+      H(j + 1, j) = 0;
+      g(j + 1) = -sn(j) * g(j);
+      g(j) = cs(j) * g(j);
+
+      ++j;
+      ++info.iterations;
+      info.residual = std::abs(g(j)) / bnorm;
+
+      if (info.residual <= tol)
+        break;
+    }
+
+    // Update with the least squares solution of the cycle
+    vec y = solve(trimatu(H.submat(0, 0, j - 1, j - 1)), g.head(j));
+    vj = V.cols(0, j - 1) * y;
+    if (M)
+      M(vj, z);
+    else
+      z = vj;
+    x += z;
+  }
+
+  info.converged = info.residual <= tol;
+
+  return info;
+}
+
+
+vec Krylov::cg(const sp_mat &A, const vec &b, Real tol, u32 maxit) {
+  vec x;
+  cg(op(A), b, x, jacobi(A), tol, maxit);
+
+  return x;
+}
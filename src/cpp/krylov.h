@@ -0,0 +1,125 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file krylov.h
+ *
+ * @brief Krylov subspace solvers for mimetic systems
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef KRYLOV_H
+#define KRYLOV_H
+
+#include "utils.h"
+#include <functional>
+
+/**
+ * @brief Convergence report of a Krylov solve
+ *
+ */
+struct KrylovInfo {
+  u32 iterations = 0;     ///< Iterations performed
+  Real residual = 0;      ///< Final relative residual ||b - Ax|| / ||b||
+  bool converged = false; ///< True if the tolerance was reached
+};
+
+/**
+ * @brief Krylov subspace solvers
+ *
+ * Operators and preconditioners are passed as y = A(x) callbacks, so
+ * assembled matrices and matrix-free operators are treated alike.
+ */
+class Krylov {
+public:
+  /**
+   * @brief Linear operator callback, writes A*x into y
+   */
+  using Operator = std::function<void(const vec &x, vec &y)>;
+
+  /**
+   * @brief Inner product callback, the Euclidean dot product if empty
+   *
+   * Lets the same iterations run on vectors split over several processes,
+   * whose inner products have to be summed over all of them. The default
+   * maxit and restart then only see the local length, so pass them too.
+   */
+  using Inner = std::function<Real(const vec &a, const vec &b)>;
+
+  /**
+   * @brief Wraps a sparse matrix as an Operator
+   *
+   * @param A a sparse matrix, must outlive the returned Operator
+   */
+  static Operator op(const sp_mat &A);
+
+  /**
+   * @brief Jacobi (diagonal) preconditioner of A
+   *
+   * @param A a sparse matrix with a nonzero diagonal
+   */
+  static Operator jacobi(const sp_mat &A);
+
+  /**
+   * @brief Preconditioned Conjugate Gradient
+   *
+   * @param A symmetric positive (semi)definite operator
+   * @param b RHS of Ax=b
+   * @param x initial guess on entry (zero if empty), solution on exit
+   * @param M symmetric positive definite preconditioner, identity if empty
+   * @param tol relative residual tolerance
+   * @param maxit maximum number of iterations, the system size if zero
+   * @param inner inner product, also defining the residual norm
+   */
+  static KrylovInfo cg(const Operator &A, const vec &b, vec &x,
+                       const Operator &M = nullptr, Real tol = 1e-10,
+                       u32 maxit = 0, const Inner &inner = nullptr);
+
+  /**
+   * @brief Right preconditioned BiCGSTAB for nonsymmetric systems
+   *
+   * @param A square operator
+   * @param b RHS of Ax=b
+   * @param x initial guess on entry (zero if empty), solution on exit
+   * @param M preconditioner, identity if empty
+   * @param tol relative residual tolerance
+   * @param maxit maximum number of iterations, the system size if zero
+   */
+  static KrylovInfo bicgstab(const Operator &A, const vec &b, vec &x,
+                             const Operator &M = nullptr, Real tol = 1e-10,
+                             u32 maxit = 0);
+
+  /**
+   * @brief Right preconditioned restarted GMRES for nonsymmetric systems
+   *
+   * @param A square operator
+   * @param b RHS of Ax=b
+   * @param x initial guess on entry (zero if empty), solution on exit
+   * @param M preconditioner, identity if empty
+   * @param tol relative residual tolerance
+   * @param maxit maximum number of iterations, the system size if zero
+   * @param restart dimension of the Krylov subspace between restarts
+   * @param inner inner product, also defining the residual norm
+   */
+  static KrylovInfo gmres(const Operator &A, const vec &b, vec &x,
+                          const Operator &M = nullptr, Real tol = 1e-10,
+                          u32 maxit = 0, u32 restart = 30,
+                          const Inner &inner = nullptr);
+
+  /**
+   * @brief Jacobi preconditioned Conjugate Gradient on a sparse matrix
+   *
+   * @param A symmetric positive (semi)definite sparse matrix
+   * @param b RHS of Ax=b
+   * @param tol relative residual tolerance
+   * @param maxit maximum number of iterations, the system size if zero
+   */
+  static vec cg(const sp_mat &A, const vec &b, Real tol = 1e-10,
+                u32 maxit = 0);
+};
+
+#endif // KRYLOV_H
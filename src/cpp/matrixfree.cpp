@@ -0,0 +1,459 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file matrixfree.cpp
+ *
+ * @brief Matrix-free mimetic operators with cache-blocked application
+ *
+ * @date 2026/10/19
+ */
+
+#include "matrixfree.h"
+#include "divergence.h"
+#include "gradient.h"
+#include "laplacian.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <set>
+#include <utility>
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+Real seconds_since(Clock::time_point start) {
+  return std::chrono::duration<Real>(Clock::now() - start).count();
+}
+
+// Per-core L2 cache, 1 MiB if the system does not report it
+uword l2_bytes() {
+#ifdef _SC_LEVEL2_CACHE_SIZE
+  long bytes = sysconf(_SC_LEVEL2_CACHE_SIZE);
+  if (bytes > 0)
+    return bytes;
+#endif
+  return 1 << 20;
+}
+
+// Circulant 1-D gradient of m cells, face i being the left face of cell i.
+// Its stencil is the interior stencil of the mimetic gradient.
+sp_mat circulant_gradient(u16 k, u32 m, Real dx) {
+  assert(m >= 2 * k);
+
+  const u32 m0 = 4 * k, mid = m0 / 2;
+  sp_mat G0 = Gradient(k, m0, dx);
+  sp_mat G(m, m);
+
+  // Row mid couples face mid with node col, that is cell col - 1
+  for (auto it = G0.begin(); it != G0.end(); ++it) {
+    if (it.row() != mid)
+      continue;
+    int s = (int)it.col() - 1 - (int)mid;
+    for (u32 f = 0; f < m; ++f)
+      G(f, (f + s + m) % m) = *it;
+  }
+
+  return G;
+}
+
+} // namespace
+
+MatrixFreeOperator::MatrixFreeOperator(Kind kind, u16 k,
+                                       const std::vector<u32> &m,
+                                       const std::vector<Real> &dx,
+                                       const std::vector<bool> &periodic) {
+  const u16 dim = m.size();
+
+  auto scalars = [&](u16 b) -> uword { return periodic[b] ? m[b] : m[b] + 2; };
+  auto faces = [&](u16 b, u16 d) -> uword {
+    return b == d && !periodic[b] ? m[b] + 1 : m[b];
+  };
+
+  uword n_scalars = 1, n_faces = 0;
+  for (u16 b = 0; b < dim; ++b)
+    n_scalars *= scalars(b);
+  for (u16 d = 0; d < dim; ++d) {
+    uword block = 1;
+    for (u16 b = 0; b < dim; ++b)
+      block *= faces(b, d);
+    n_faces += block;
+  }
+
+  rows = kind == GRADIENT ? n_faces : n_scalars;
+  cols = kind == DIVERGENCE ? n_faces : n_scalars;
+
+  uword offset = 0;
+  for (u16 d = 0; d < dim; ++d) {
+    // 1-D operator of this axis
+    sp_mat A;
+    if (periodic[d]) {
+      sp_mat G = circulant_gradient(k, m[d], dx[d]);
+      if (kind == GRADIENT)
+        A = G;
+      else if (kind == DIVERGENCE)
+        A = -G.t();
+      else
+        A = -G.t() * G;
+    } else {
+      if (kind == GRADIENT)
+        A = Gradient(k, m[d], dx[d]);
+      else if (kind == DIVERGENCE)
+        A = Divergence(k, m[d], dx[d]);
+      else
+        A = Laplacian(k, m[d], dx[d]);
+    }
+    bands.emplace_back(A, periodic[d]);
+
+    Term t;
+    t.axis = d;
+    t.band = bands.size() - 1;
+
+    for (u16 b = 0; b < 3; ++b) {
+      if (b >= dim || b == d) {
+        t.in[b] = b == d ? A.n_cols : 1;
+        t.out[b] = b == d ? A.n_rows : 1;
+        t.lo[b] = 0;
+        t.hi[b] = t.out[b];
+        t.shift[b] = 0;
+        continue;
+      }
+
+      // Other axes: faces only exist inside a non-periodic axis, and
+      // divergence and Laplacian leave its boundary nodes empty
+      bool p = periodic[b];
+      switch (kind) {
+      case GRADIENT:
+        t.in[b] = scalars(b);
+        t.out[b] = m[b];
+        t.lo[b] = 0;
+        t.shift[b] = p ? 0 : 1;
+        break;
+      case DIVERGENCE:
+        t.in[b] = m[b];
+        t.out[b] = scalars(b);
+        t.lo[b] = p ? 0 : 1;
+        t.shift[b] = p ? 0 : -1;
+        break;
+      case LAPLACIAN:
+        t.in[b] = t.out[b] = scalars(b);
+        t.lo[b] = p ? 0 : 1;
+        t.shift[b] = 0;
+        break;
+      }
+      t.hi[b] = t.lo[b] + m[b];
+    }
+
+    t.in_offset = kind == DIVERGENCE ? offset : 0;
+    t.out_offset = kind == GRADIENT ? offset : 0;
+    if (kind != LAPLACIAN)
+      offset += (kind == GRADIENT ? t.out[0] * t.out[1] * t.out[2]
+                                  : t.in[0] * t.in[1] * t.in[2]);
+
+    terms.push_back(t);
+  }
+
+  for (const Term &t : terms)
+    for (u16 b = 0; b < 3; ++b)
+      extent[b] = std::max(extent[b], t.out[b]);
+}
+
+void MatrixFreeOperator::apply(const vec &x, vec &y) const {
+  assert(x.n_elem == cols);
+  // Not zeroed here, every line is cleared by the thread that writes it
+  if (y.n_elem != rows)
+    y.set_size(rows);
+
+  const Real *X = x.memptr();
+  Real *Y = y.memptr();
+
+  // Terms of Divergence and Laplacian share one output block, those of
+  // Gradient have one each; a block is cleared by its first term
+  auto clears = [&](size_t n) {
+    return n == 0 || terms[n].out_offset != terms[n - 1].out_offset;
+  };
+
+  if (!tile[0]) {
+    // Lines of a block in storage order, split the same way by every term
+    for (size_t n = 0; n < terms.size(); ++n) {
+      const Term &t = terms[n];
+      const bool clear = clears(n);
+      const int lines = t.out[1] * t.out[2];
+
+#pragma omp parallel for schedule(static)
+      for (int q = 0; q < lines; ++q) {
+        const uword j = q % t.out[1], l = q / t.out[1];
+        if (clear)
+          std::fill_n(Y + t.out_offset + t.out[0] * (j + t.out[1] * l),
+                      t.out[0], 0.0);
+        line(t, X, Y, j, l, t.lo[0], t.hi[0]);
+      }
+    }
+    return;
+  }
+
+  // Every term is applied to a tile before the next tile, tiles partition
+  // the outputs of every term so they can run concurrently. Tiles are
+  // handed out statically in storage order, so a thread writes the same
+  // ones on every apply.
+  uword nt[3];
+  for (u16 b = 0; b < 3; ++b)
+    nt[b] = (extent[b] + tile[b] - 1) / tile[b];
+  const int tiles = nt[0] * nt[1] * nt[2];
+
+#pragma omp parallel for schedule(static)
+  for (int q = 0; q < tiles; ++q) {
+    const uword c[3] = {q % nt[0], (q / nt[0]) % nt[1], q / (nt[0] * nt[1])};
+    uword lo[3], hi[3];
+    for (u16 b = 0; b < 3; ++b) {
+      lo[b] = c[b] * tile[b];
+      hi[b] = std::min<uword>(lo[b] + tile[b], extent[b]);
+    }
+
+    for (size_t n = 0; n < terms.size(); ++n) {
+      const Term &t = terms[n];
+      const bool clear = clears(n);
+      const uword i0 = std::max(t.lo[0], lo[0]), i1 = std::min(t.hi[0], hi[0]);
+      const uword e0 = std::min(t.out[0], hi[0]);
+
+      for (uword l = lo[2]; l < std::min(t.out[2], hi[2]); ++l)
+        for (uword j = lo[1]; j < std::min(t.out[1], hi[1]); ++j) {
+          if (clear && lo[0] < e0)
+            std::fill_n(Y + t.out_offset + t.out[0] * (j + t.out[1] * l) +
+                            lo[0],
+                        e0 - lo[0], 0.0);
+          line(t, X, Y, j, l, i0, i1);
+        }
+    }
+  }
+}
+
+void MatrixFreeOperator::set_tiles(u32 tx, u32 ty, u32 tz) {
+  if (!tx && !ty && !tz) {
+    tile = {{0, 0, 0}};
+    return;
+  }
+  assert(tx && ty && tz);
+  tile = {{tx, ty, tz}};
+}
+
+Real MatrixFreeOperator::autotune(u32 trials) {
+  assert(trials > 0);
+
+  // Entries a tile reads around its outputs, and arrays per side
+  uword halo = 0;
+  for (const StencilBand &B : bands)
+    halo = std::max<uword>(halo, B.stencil.size());
+  const uword nodes = extent[0] * extent[1] * extent[2];
+  const uword ins = std::max<uword>(1, cols / nodes);
+  const uword outs = std::max<uword>(1, rows / nodes);
+
+  // Untiled first, then tiles that fit in L2, full x-lines or not
+  std::set<std::array<u32, 3>> candidates;
+  candidates.insert({{0, 0, 0}});
+  for (uword tx : {extent[0], (uword)64})
+    for (uword ty : {4, 8, 16, 32, 64})
+      for (uword tz : {4, 8, 16, 32, 64}) {
+        std::array<uword, 3> t{{std::min(tx, extent[0]), std::min(ty, extent[1]),
+                                std::min(tz, extent[2])}};
+        uword in = 1, out = 1;
+        for (u16 b = 0; b < 3; ++b) {
+          in *= std::min(t[b] + 2 * halo, extent[b]);
+          out *= t[b];
+        }
+        if (sizeof(Real) * (ins * in + outs * out) <= l2_bytes())
+          candidates.insert({{(u32)t[0], (u32)t[1], (u32)t[2]}});
+      }
+
+  vec x = randu<vec>(cols), y(rows);
+  std::array<u32, 3> best = tile;
+  Real best_time = -1;
+
+  for (const auto &c : candidates) {
+    tile = c;
+    apply(x, y); // Warm up
+
+    Real time = 0;
+    for (u32 r = 0; r < trials; ++r) {
+      auto start = Clock::now();
+      apply(x, y);
+      Real t = seconds_since(start);
+      time = r ? std::min(time, t) : t;
+    }
+
+    if (best_time < 0 || time < best_time) {
+      best_time = time;
+      best = c;
+    }
+  }
+
+  tile = best;
+  return best_time;
+}
+
+void MatrixFreeOperator::axpy(Real a, const vec &x, vec &y,
+                              const std::array<uword, 3> &lo,
+                              const std::array<uword, 3> &hi) const {
+  assert(rows == cols && x.n_elem == cols && y.n_elem == rows);
+
+  const Real *X = x.memptr();
+  Real *Y = y.memptr();
+  const uword nj = hi[1] - lo[1];
+  const int lines = nj * (hi[2] - lo[2]);
+
+#pragma omp for schedule(static)
+  for (int q = 0; q < lines; ++q) {
+    const uword j = lo[1] + q % nj, l = lo[2] + q / nj;
+    const uword start = extent[0] * (j + extent[1] * l);
+    std::copy(X + start + lo[0], X + start + hi[0], Y + start + lo[0]);
+    for (const Term &t : terms)
+      line(t, X, Y, j, l, std::max(t.lo[0], lo[0]), std::min(t.hi[0], hi[0]),
+           a);
+  }
+}
+
+uword MatrixFreeOperator::reach(u16 axis) const {
+  uword r = 0;
+  for (const Term &t : terms) {
+    if (t.axis != axis)
+      r = std::max<uword>(r, std::abs(t.shift[axis]));
+    else if (bands[t.band].periodic)
+      return extent[axis];
+    else
+      r = std::max<uword>(r, bands[t.band].reach);
+  }
+  return r;
+}
+
+Krylov::Operator MatrixFreeOperator::op() const {
+  return [this](const vec &x, vec &y) { apply(x, y); };
+}
+
+void MatrixFreeOperator::line(const Term &t, const Real *x, Real *y,
+                              uword j, uword l, uword i0, uword i1,
+                              Real scale) const {
+  if (j < t.lo[1] || j >= t.hi[1] || l < t.lo[2] || l >= t.hi[2] || i0 >= i1)
+    return;
+
+  const StencilBand &B = bands[t.band];
+  const std::ptrdiff_t si[3] = {1, (std::ptrdiff_t)t.in[0],
+                                (std::ptrdiff_t)(t.in[0] * t.in[1])};
+  const std::ptrdiff_t so[3] = {1, (std::ptrdiff_t)t.out[0],
+                                (std::ptrdiff_t)(t.out[0] * t.out[1])};
+  const Real *X = x + t.in_offset;
+  Real *yl = y + t.out_offset + so[1] * j + so[2] * l;
+
+  // Column along the axis, wrapped around if periodic
+  const int n = B.cols;
+  auto wrap = [&](int c) {
+    if (B.periodic) {
+      if (c < 0)
+        c += n;
+      else if (c >= n)
+        c -= n;
+    }
+    return c;
+  };
+
+  int col, count;
+  const Real *w;
+
+  if (t.axis == 0) {
+    // Rows of the stencil run along the contiguous axis
+    const Real *xr = X + si[1] * ((std::ptrdiff_t)j + t.shift[1]) +
+                     si[2] * ((std::ptrdiff_t)l + t.shift[2]);
+
+    // Interior rows [r0, r1), whose columns need no wrap-around, as one
+    // SIMD sweep per weight; the other rows one at a time
+    const std::ptrdiff_t width = B.stencil.size();
+    const std::ptrdiff_t lo = std::max<std::ptrdiff_t>(B.lo, -B.first);
+    const std::ptrdiff_t hi = std::min<std::ptrdiff_t>(B.N - B.hi,
+                                                       n - B.first - width + 1);
+    auto clamp = [&](std::ptrdiff_t r, std::ptrdiff_t a) -> uword {
+      return std::min<std::ptrdiff_t>(std::max(r, a), i1);
+    };
+    const uword r0 = clamp(lo, i0), r1 = clamp(hi, r0);
+
+    for (uword i = i0; i < i1; ++i) {
+      if (i == r0)
+        i = r1;
+      if (i >= i1)
+        break;
+      B.row(i, col, w, count);
+      Real sum = 0;
+      for (int c = 0; c < count; ++c)
+        sum += w[c] * xr[wrap(col + c)];
+      yl[i] += scale * sum;
+    }
+
+    for (std::ptrdiff_t c = 0; c < width; ++c) {
+      const Real *xs = xr + B.first + c;
+      const Real wc = scale * B.stencil[c];
+#pragma omp simd
+      for (std::ptrdiff_t i = r0; i < (std::ptrdiff_t)r1; ++i)
+        yl[i] += wc * xs[i];
+    }
+    return;
+  }
+
+  // A combination of x-lines: row r along the axis, a along the other one
+  const u16 d = t.axis, e = d == 1 ? 2 : 1;
+  const uword r = d == 1 ? j : l, a = d == 1 ? l : j;
+  const std::ptrdiff_t s0 = t.shift[0];
+
+  B.row(r, col, w, count);
+  for (int c = 0; c < count; ++c) {
+    const Real *xl = X + si[d] * wrap(col + c) +
+                     si[e] * ((std::ptrdiff_t)a + t.shift[e]);
+    const Real wc = scale * w[c];
+#pragma omp simd
+    for (std::ptrdiff_t i = i0; i < (std::ptrdiff_t)i1; ++i)
+      yl[i] += wc * xl[i + s0];
+  }
+}
+
+MatrixFreeGradient::MatrixFreeGradient(u16 k, u32 m, Real dx, bool px)
+    : MatrixFreeOperator(GRADIENT, k, {m}, {dx}, {px}) {}
+
+MatrixFreeGradient::MatrixFreeGradient(u16 k, u32 m, u32 n, Real dx, Real dy,
+                                       bool px, bool py)
+    : MatrixFreeOperator(GRADIENT, k, {m, n}, {dx, dy}, {px, py}) {}
+
+MatrixFreeGradient::MatrixFreeGradient(u16 k, u32 m, u32 n, u32 o, Real dx,
+                                       Real dy, Real dz, bool px, bool py,
+                                       bool pz)
+    : MatrixFreeOperator(GRADIENT, k, {m, n, o}, {dx, dy, dz}, {px, py, pz}) {}
+
+MatrixFreeDivergence::MatrixFreeDivergence(u16 k, u32 m, Real dx, bool px)
+    : MatrixFreeOperator(DIVERGENCE, k, {m}, {dx}, {px}) {}
+
+MatrixFreeDivergence::MatrixFreeDivergence(u16 k, u32 m, u32 n, Real dx,
+                                           Real dy, bool px, bool py)
+    : MatrixFreeOperator(DIVERGENCE, k, {m, n}, {dx, dy}, {px, py}) {}
+
+MatrixFreeDivergence::MatrixFreeDivergence(u16 k, u32 m, u32 n, u32 o,
+                                           Real dx, Real dy, Real dz, bool px,
+                                           bool py, bool pz)
+    : MatrixFreeOperator(DIVERGENCE, k, {m, n, o}, {dx, dy, dz},
+                         {px, py, pz}) {}
+
+MatrixFreeLaplacian::MatrixFreeLaplacian(u16 k, u32 m, Real dx, bool px)
+    : MatrixFreeOperator(LAPLACIAN, k, {m}, {dx}, {px}) {}
+
+MatrixFreeLaplacian::MatrixFreeLaplacian(u16 k, u32 m, u32 n, Real dx, Real dy,
+                                         bool px, bool py)
+    : MatrixFreeOperator(LAPLACIAN, k, {m, n}, {dx, dy}, {px, py}) {}
+
+MatrixFreeLaplacian::MatrixFreeLaplacian(u16 k, u32 m, u32 n, u32 o, Real dx,
+                                         Real dy, Real dz, bool px, bool py,
+                                         bool pz)
+    : MatrixFreeOperator(LAPLACIAN, k, {m, n, o}, {dx, dy, dz}, {px, py, pz}) {}
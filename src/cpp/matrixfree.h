@@ -0,0 +1,275 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file matrixfree.h
+ *
+ * @brief Matrix-free mimetic operators with cache-blocked application
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef MATRIXFREE_H
+#define MATRIXFREE_H
+
+#include "krylov.h"
+#include "stencilband.h"
+#include "utils.h"
+#include <array>
+#include <vector>
+
+/**
+ * @brief Matrix-free mimetic operator, optionally periodic along any axis
+ *
+ * By default every axis has boundary nodes and the operator is the
+ * matrix-free counterpart of Gradient, Divergence or Laplacian. Along a
+ * periodic axis of m cells there are no boundary nodes: scalars
+ * live on the m centers and vectors on the m faces, face i being the left
+ * face of cell i, and the 1-D operators are circulant as in
+ * gradPeriodic.m, divPeriodic.m (D = -G') and lapPeriodic.m. Along the
+ * other axes the usual mimetic operators with boundary nodes are used.
+ * Unknowns are ordered x fastest, vectors by component as for Gradient.
+ *
+ * The operator is never assembled: every axis keeps its 1-D stencil (and
+ * the boundary rows of a non-periodic axis), which are applied along that
+ * axis with wrap-around indexing on periodic axes.
+ *
+ * By default apply() sweeps the whole grid once per axis. In 3-D the
+ * z-neighbors of a row are (m+2)(n+2) entries apart, so on large grids
+ * every sweep streams x and y through memory again. With tiles set, the
+ * grid is walked in x-y-z blocks instead, all axes are applied to a block
+ * while it is in cache, and the blocks run in parallel (OpenMP). Either
+ * way every thread zeroes and writes the same x-lines of y on every
+ * apply(), so a newly allocated y is first touched by its writers.
+ */
+class MatrixFreeOperator {
+public:
+  /**
+   * @brief y = A*x
+   */
+  void apply(const vec &x, vec &y) const;
+
+  /**
+   * @brief The operator as a Krylov::Operator, must outlive it
+   */
+  Krylov::Operator op() const;
+
+  /**
+   * @brief Walks apply() in tiles of tx x ty x tz output entries, or sweeps
+   * the whole grid per axis if all are zero
+   */
+  void set_tiles(u32 tx, u32 ty, u32 tz);
+
+  /**
+   * @brief Current tile sizes along x, y and z, zero if not tiled
+   */
+  std::array<u32, 3> tiles() const { return tile; }
+
+  /**
+   * @brief Times apply() for the untiled sweep and for the tiles whose
+   * working set fits in the L2 cache, and keeps the fastest
+   *
+   * @param trials applies timed per candidate, the best one counts
+   * @return seconds per apply() with the chosen tiles
+   */
+  Real autotune(u32 trials = 2);
+
+  /**
+   * @brief y = x + a*A*x over the output box [lo, hi), x fastest, for an
+   * operator whose input and output share a layout (Laplacian)
+   *
+   * The lines of the box are split over the threads of the enclosing
+   * parallel region, if any, so time steppers can sweep the grid a box at a
+   * time. x and y must not overlap.
+   */
+  void axpy(Real a, const vec &x, vec &y, const std::array<uword, 3> &lo,
+            const std::array<uword, 3> &hi) const;
+
+  /**
+   * @brief Entries per axis of the largest output block, x fastest
+   */
+  std::array<uword, 3> shape() const {
+    return {{extent[0], extent[1], extent[2]}};
+  }
+
+  /**
+   * @brief Farthest input entry from an output entry along an axis, the
+   * whole axis if it is periodic
+   */
+  uword reach(u16 axis) const;
+
+  /**
+   * @brief Number of rows and columns of the operator
+   */
+  uword n_rows() const { return rows; }
+  uword n_cols() const { return cols; }
+
+protected:
+  enum Kind { GRADIENT, DIVERGENCE, LAPLACIAN };
+
+  MatrixFreeOperator(Kind kind, u16 k, const std::vector<u32> &m,
+                     const std::vector<Real> &dx,
+                     const std::vector<bool> &periodic);
+
+private:
+  // y block += band along axis applied to x block, over an output box
+  struct Term {
+    u16 axis;
+    size_t band;
+    uword in[3], out[3];        // Block dimensions, x fastest
+    uword in_offset, out_offset;
+    uword lo[3], hi[3];         // Output box, full range along axis
+    int shift[3];               // Input index minus output index
+  };
+
+  // scale times term t on output x-line (j, l) over [i0, i1), nothing
+  // outside its box
+  void line(const Term &t, const Real *x, Real *y, uword j, uword l,
+            uword i0, uword i1, Real scale = 1) const;
+
+  std::vector<StencilBand> bands;
+  std::vector<Term> terms;
+  uword rows = 0, cols = 0;
+  uword extent[3] = {1, 1, 1};      // Largest output box of the terms
+  std::array<u32, 3> tile{{0, 0, 0}};
+};
+
+/**
+ * @brief Matrix-free mimetic Gradient, periodic along the flagged axes
+ */
+class MatrixFreeGradient : public MatrixFreeOperator {
+public:
+  /**
+   * @brief 1-D Gradient, periodic if flagged
+   *
+   * @param k Order of accuracy
+   * @param m Number of cells
+   * @param dx Spacing between cells
+   * @param px Periodicity of the axis
+   */
+  MatrixFreeGradient(u16 k, u32 m, Real dx, bool px = false);
+
+  /**
+   * @brief 2-D Gradient, periodic along the flagged axes
+   *
+   * @param k Order of accuracy
+   * @param m Number of cells in x-direction
+   * @param n Number of cells in y-direction
+   * @param dx Spacing between cells in x-direction
+   * @param dy Spacing between cells in y-direction
+   * @param px, py Periodicity of each axis
+   */
+  MatrixFreeGradient(u16 k, u32 m, u32 n, Real dx, Real dy, bool px = false,
+                     bool py = false);
+
+  /**
+   * @brief 3-D Gradient, periodic along the flagged axes
+   *
+   * @param k Order of accuracy
+   * @param m Number of cells in x-direction
+   * @param n Number of cells in y-direction
+   * @param o Number of cells in z-direction
+   * @param dx Spacing between cells in x-direction
+   * @param dy Spacing between cells in y-direction
+   * @param dz Spacing between cells in z-direction
+   * @param px, py, pz Periodicity of each axis
+   */
+  MatrixFreeGradient(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz,
+                     bool px = false, bool py = false, bool pz = false);
+};
+
+/**
+ * @brief Matrix-free mimetic Divergence, periodic along the flagged axes
+ */
+class MatrixFreeDivergence : public MatrixFreeOperator {
+public:
+  /**
+   * @brief 1-D Divergence, periodic if flagged
+   *
+   * @param k Order of accuracy
+   * @param m Number of cells
+   * @param dx Spacing between cells
+   * @param px Periodicity of the axis
+   */
+  MatrixFreeDivergence(u16 k, u32 m, Real dx, bool px = false);
+
+  /**
+   * @brief 2-D Divergence, periodic along the flagged axes
+   *
+   * @param k Order of accuracy
+   * @param m Number of cells in x-direction
+   * @param n Number of cells in y-direction
+   * @param dx Spacing between cells in x-direction
+   * @param dy Spacing between cells in y-direction
+   * @param px, py Periodicity of each axis
+   */
+  MatrixFreeDivergence(u16 k, u32 m, u32 n, Real dx, Real dy, bool px = false,
+                       bool py = false);
+
+  /**
+   * @brief 3-D Divergence, periodic along the flagged axes
+   *
+   * @param k Order of accuracy
+   * @param m Number of cells in x-direction
+   * @param n Number of cells in y-direction
+   * @param o Number of cells in z-direction
+   * @param dx Spacing between cells in x-direction
+   * @param dy Spacing between cells in y-direction
+   * @param dz Spacing between cells in z-direction
+   * @param px, py, pz Periodicity of each axis
+   */
+  MatrixFreeDivergence(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz,
+                       bool px = false, bool py = false, bool pz = false);
+};
+
+/**
+ * @brief Matrix-free mimetic Laplacian, periodic along the flagged axes
+ *
+ * Applied as the sum of the 1-D Laplacians D*G of every axis rather than
+ * as a divergence of a gradient, so no vector field is formed.
+ */
+class MatrixFreeLaplacian : public MatrixFreeOperator {
+public:
+  /**
+   * @brief 1-D Laplacian, periodic if flagged
+   *
+   * @param k Order of accuracy
+   * @param m Number of cells
+   * @param dx Spacing between cells
+   * @param px Periodicity of the axis
+   */
+  MatrixFreeLaplacian(u16 k, u32 m, Real dx, bool px = false);
+
+  /**
+   * @brief 2-D Laplacian, periodic along the flagged axes
+   *
+   * @param k Order of accuracy
+   * @param m Number of cells in x-direction
+   * @param n Number of cells in y-direction
+   * @param dx Spacing between cells in x-direction
+   * @param dy Spacing between cells in y-direction
+   * @param px, py Periodicity of each axis
+   */
+  MatrixFreeLaplacian(u16 k, u32 m, u32 n, Real dx, Real dy, bool px = false,
+                      bool py = false);
+
+  /**
+   * @brief 3-D Laplacian, periodic along the flagged axes
+   *
+   * @param k Order of accuracy
+   * @param m Number of cells in x-direction
+   * @param n Number of cells in y-direction
+   * @param o Number of cells in z-direction
+   * @param dx Spacing between cells in x-direction
+   * @param dy Spacing between cells in y-direction
+   * @param dz Spacing between cells in z-direction
+   * @param px, py, pz Periodicity of each axis
+   */
+  MatrixFreeLaplacian(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz,
+                      bool px = false, bool py = false, bool pz = false);
+};
+
+#endif // MATRIXFREE_H
@@ -0,0 +1,187 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file mimetic.cpp
+ *
+ * @brief Coefficients of the mimetic operators of any even order
+ *
+ * @date 2026/10/19
+ */
+
+#include "mimetic.h"
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+using Dense = std::vector<std::vector<long double>>;
+
+// Solves A x = b by Gaussian elimination with partial pivoting
+std::vector<long double> solve(Dense A, std::vector<long double> b) {
+  const size_t n = b.size();
+
+  for (size_t c = 0; c < n; ++c) {
+    size_t p = c;
+    for (size_t r = c + 1; r < n; ++r)
+      if (std::fabs(A[r][c]) > std::fabs(A[p][c]))
+        p = r;
+    if (A[p][c] == 0)
+      throw std::runtime_error("Mimetic: singular weight system");
+    std::swap(A[c], A[p]);
+    std::swap(b[c], b[p]);
+
+    for (size_t r = c + 1; r < n; ++r) {
+      long double f = A[r][c] / A[c][c];
+      for (size_t j = c; j < n; ++j)
+        A[r][j] -= f * A[c][j];
+      b[r] -= f * b[c];
+    }
+  }
+
+  std::vector<long double> x(n);
+  for (size_t c = n; c-- > 0;) {
+    long double s = b[c];
+    for (size_t j = c + 1; j < n; ++j)
+      s -= A[c][j] * x[j];
+    x[c] = s / A[c][c];
+  }
+  return x;
+}
+
+// Gradient of m cells with unit spacing, (m + 1) x (m + 2)
+Dense gradient(u16 k, u32 m, const std::vector<long double> &interior,
+               const Dense &boundary) {
+  Dense G(m + 1, std::vector<long double>(m + 2, 0));
+  for (u32 r = 0; r < k / 2u; ++r)
+    for (u32 c = 0; c <= k; ++c) {
+      G[r][c] = boundary[r][c];
+      G[m - r][m + 1 - c] = -boundary[r][c];
+    }
+  for (u32 i = k / 2; i <= m - k / 2; ++i)
+    for (u32 c = 0; c < k; ++c)
+      G[i][i - k / 2 + 1 + c] = interior[c];
+  return G;
+}
+
+// Divergence of m cells with unit spacing, (m + 2) x (m + 1)
+Dense divergence(u16 k, u32 m, const std::vector<long double> &interior,
+                 const Dense &boundary) {
+  Dense D(m + 2, std::vector<long double>(m + 1, 0));
+  for (u32 r = 0; r + 1 < k / 2u; ++r)
+    for (u32 c = 0; c <= k; ++c) {
+      D[r + 1][c] = boundary[r][c];
+      D[m - r][m - c] = -boundary[r][c];
+    }
+  for (u32 i = k / 2; i <= m + 1 - k / 2; ++i)
+    for (u32 c = 0; c < k; ++c)
+      D[i][i - k / 2 + c] = interior[c];
+  return D;
+}
+
+std::vector<Real> rounded(const std::vector<long double> &w) {
+  return std::vector<Real>(w.begin(), w.end());
+}
+
+MimeticStencils generate(u16 k) {
+  const u16 h = k / 2;
+
+  // Centers at half-integers, the boundary node at 0, faces at integers
+  std::vector<long double> centers(k), nodes(k + 1), faces(k + 1);
+  for (u16 c = 0; c < k; ++c)
+    centers[c] = c - h + 0.5L;
+  nodes[0] = 0;
+  for (u16 c = 1; c <= k; ++c)
+    nodes[c] = c - 0.5L;
+  for (u16 c = 0; c <= k; ++c)
+    faces[c] = c;
+
+  std::vector<long double> interior = Mimetic::lagrange(centers, 0);
+  Dense grad, div;
+  for (u16 r = 0; r < h; ++r)
+    grad.push_back(Mimetic::lagrange(nodes, r));
+  for (u16 r = 0; r + 1 < h; ++r)
+    div.push_back(Mimetic::lagrange(faces, r + 0.5L));
+
+  MimeticStencils s;
+  s.interior = rounded(interior);
+  for (auto &w : grad)
+    s.gradient.push_back(rounded(w));
+  for (auto &w : div)
+    s.divergence.push_back(rounded(w));
+
+  // G'P = [-1 0 ... 0 1]' on 2k cells, the last equation is redundant
+  u32 m = 2 * k;
+  Dense G = gradient(k, m, interior, grad);
+  Dense A(m + 1, std::vector<long double>(m + 1));
+  for (u32 i = 0; i <= m; ++i)
+    for (u32 j = 0; j <= m; ++j)
+      A[i][j] = G[j][i];
+  std::vector<long double> b(m + 1, 0);
+  b[0] = -1;
+  s.P = rounded(solve(A, b));
+
+  // The same with the interior rows of D on 2k + 1 cells
+  m = 2 * k + 1;
+  Dense D = divergence(k, m, interior, div);
+  A.assign(m, std::vector<long double>(m));
+  for (u32 i = 0; i < m; ++i)
+    for (u32 j = 0; j < m; ++j)
+      A[i][j] = D[j + 1][i];
+  b.assign(m, 0);
+  b[0] = -1;
+  s.Q = rounded(solve(A, b));
+
+  return s;
+}
+
+} // namespace
+
+std::vector<long double> Mimetic::lagrange(const std::vector<long double> &points,
+                                           long double x) {
+  const size_t n = points.size();
+  std::vector<long double> w(n, 0);
+
+  for (size_t j = 0; j < n; ++j) {
+    long double den = 1;
+    for (size_t l = 0; l < n; ++l)
+      if (l != j)
+        den *= points[j] - points[l];
+
+    // Derivative of prod_{l != j} (x - points[l])
+    long double sum = 0;
+    for (size_t i = 0; i < n; ++i) {
+      if (i == j)
+        continue;
+      long double p = 1;
+      for (size_t l = 0; l < n; ++l)
+        if (l != j && l != i)
+          p *= x - points[l];
+      sum += p;
+    }
+    w[j] = sum / den;
+  }
+
+  return w;
+}
+
+const MimeticStencils &Mimetic::stencils(u16 k) {
+  if (k % 2 || k < 2)
+    throw std::invalid_argument("Mimetic: k must be even and at least 2");
+
+  static std::mutex lock;
+  static std::map<u16, MimeticStencils> cache;
+
+  std::lock_guard<std::mutex> guard(lock);
+  auto it = cache.find(k);
+  if (it != cache.end())
+    return it->second;
+
+  return cache.emplace(k, generate(k)).first->second;
+}
@@ -0,0 +1,70 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file mimetic.h
+ *
+ * @brief Coefficients of the mimetic operators of any even order
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef MIMETIC_H
+#define MIMETIC_H
+
+#include "utils.h"
+#include <vector>
+
+/**
+ * @brief Stencils and weights of the 1-D mimetic operators of order k,
+ * with unit spacing
+ */
+struct MimeticStencils {
+  std::vector<Real> interior;                ///< k weights, centered
+  std::vector<std::vector<Real>> gradient;   ///< k/2 left boundary rows
+  std::vector<std::vector<Real>> divergence; ///< k/2 - 1 left boundary rows
+  std::vector<Real> P;                       ///< Gradient weights, 2k cells
+  std::vector<Real> Q;                       ///< Divergence weights, 2k + 1 cells
+};
+
+/**
+ * @brief Generator of the mimetic coefficients for any even order
+ *
+ * The interior rows of Gradient and Divergence are the centered
+ * differences over k points half a cell apart. The boundary rows are
+ * the one-sided differences over k + 1 points: Gradient row r at face r
+ * from the boundary node and the first k centers, Divergence row r + 1 at
+ * center r + 1/2 from the first k + 1 faces. The right boundary rows are
+ * the left ones reversed and negated. These are the coefficients typed
+ * into gradient.cpp and divergence.cpp. The weights P and Q then follow
+ * from G'P = [-1 0 ... 0 1]' and D'Q = [-1 0 ... 0 1]' on the smallest
+ * grids, as in weightsP.m and weightsQ.m.
+ *
+ * Weights of Lagrange stencils are closed products, evaluated in long
+ * double; P and Q are solved in long double too. Everything is computed
+ * once per order, on first use.
+ *
+ * @note Q has negative weights from k = 8 on and P from k = 10 on, the
+ * inner products are then no longer positive.
+ */
+class Mimetic {
+public:
+  /**
+   * @brief Stencils of order k
+   *
+   * @param k Order of accuracy, even and at least 2
+   */
+  static const MimeticStencils &stencils(u16 k);
+
+  /**
+   * @brief Weights of the derivative at x of the Lagrange interpolant
+   * through the given points
+   */
+  static std::vector<long double> lagrange(const std::vector<long double> &points,
+                                           long double x);
+};
+
+#endif // MIMETIC_H
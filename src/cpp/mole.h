@@ -16,13 +16,36 @@
 #ifndef MOLE_H
 #define MOLE_H
 
+#include "adaptiveintegrator.h"
+#include "amr.h"
+#include "distributed.h"
+#include "distributedkrylov.h"
 #include "divergence.h"
+#include "eigensolver.h"
+#include "expmv.h"
 #include "gradient.h"
+#include "grid.h"
+#include "imexintegrator.h"
+#include "implicitintegrator.h"
+#include "integrator.h"
 #include "interpol.h"
+#include "jacobian.h"
+#include "krylov.h"
 #include "laplacian.h"
+#include "matrixfree.h"
+#include "mimetic.h"
 #include "mixedbc.h"
+#include "nodal.h"
+#include "numa.h"
 #include "operators.h"
+#include "parareal.h"
+#include "periodic.h"
 #include "robinbc.h"
+#include "schwarz.h"
+#include "solver.h"
+#include "stencilband.h"
+#include "stencillaplacian.h"
 #include "utils.h"
+#include "weightedlaplacian.h"
 
 #endif // MOLE_H
@@ -0,0 +1,216 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file nodal.cpp
+ *
+ * @brief Nodal and sided nodal derivative operators
+ *
+ * @date 2026/10/19
+ */
+
+#include "nodal.h"
+#include "mimetic.h"
+#include <algorithm>
+#include <cassert>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+namespace {
+
+// Weights of the first derivative at offset r of the nodes 0 ... k
+std::vector<Real> weights(u16 k, int r) {
+  std::vector<long double> nodes(k + 1);
+  for (u16 j = 0; j <= k; ++j)
+    nodes[j] = j;
+
+  std::vector<long double> w = Mimetic::lagrange(nodes, r);
+  return std::vector<Real>(w.begin(), w.end());
+}
+
+// Row i of the operator on N nodes as its first column and weights, in
+// reverse (and negated) for the right boundary rows
+struct Stencil {
+  int first;
+  const Real *w;
+  bool mirrored;
+};
+
+Stencil stencil(const std::vector<std::vector<Real>> &table, u16 k, int i,
+                int N) {
+  const int h = k / 2;
+  if (i < h)
+    return {0, table[i].data(), false};
+  if (i >= N - h)
+    return {N - k - 1, table[N - 1 - i].data(), true};
+  return {i - h, table[h].data(), false};
+}
+
+} // namespace
+
+const std::vector<std::vector<Real>> &Nodal::coefficients(u16 k) {
+  if (k % 2 || k < 2)
+    throw std::invalid_argument("Nodal: k must be even and at least 2");
+
+  static std::mutex lock;
+  static std::map<u16, std::vector<std::vector<Real>>> tables;
+
+  std::lock_guard<std::mutex> guard(lock);
+  auto it = tables.find(k);
+  if (it != tables.end())
+    return it->second;
+
+  std::vector<std::vector<Real>> table;
+  for (int r = 0; r <= k / 2; ++r)
+    table.push_back(weights(k, r));
+
+  return tables.emplace(k, std::move(table)).first->second;
+}
+
+Nodal::Nodal(u16 k, u32 m, Real dx) : sp_mat(m + 1, m + 1) {
+  const auto &table = coefficients(k);
+  if (m < k)
+    throw std::invalid_argument("Nodal: need at least k cells");
+
+  const int N = m + 1;
+  for (int i = 0; i < N; ++i) {
+    Stencil r = stencil(table, k, i, N);
+    for (int c = 0; c <= k; ++c)
+      at(i, r.first + c) = r.mirrored ? -r.w[k - c] / dx : r.w[c] / dx;
+  }
+}
+
+Nodal::Nodal(u16 k, u32 m, u32 n, Real dx, Real dy) {
+  Nodal Nx(k, m, dx);
+  Nodal Ny(k, n, dy);
+
+  sp_mat Im = speye(m + 1, m + 1);
+  sp_mat In = speye(n + 1, n + 1);
+
+  *this = Utils::spjoin_cols(Utils::spkron(In, Nx), Utils::spkron(Ny, Im));
+}
+
+Nodal::Nodal(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz) {
+  Nodal Nx(k, m, dx);
+  Nodal Ny(k, n, dy);
+  Nodal Nz(k, o, dz);
+
+  sp_mat Im = speye(m + 1, m + 1);
+  sp_mat In = speye(n + 1, n + 1);
+  sp_mat Io = speye(o + 1, o + 1);
+
+  sp_mat Dx = Utils::spkron(Utils::spkron(Io, In), Nx);
+  sp_mat Dy = Utils::spkron(Utils::spkron(Io, Ny), Im);
+  sp_mat Dz = Utils::spkron(Utils::spkron(Nz, In), Im);
+
+  *this = Utils::spjoin_cols(Utils::spjoin_cols(Dx, Dy), Dz);
+}
+
+void Nodal::apply(u16 k, const cube &u, cube &du, u16 axis, Real h) {
+  assert(axis < 3);
+  const auto &table = coefficients(k);
+
+  const uword dims[3] = {u.n_rows, u.n_cols, u.n_slices};
+  const int N = dims[axis];
+  if (N < k + 1)
+    throw std::invalid_argument("Nodal: need at least k cells");
+
+  du.set_size(u.n_rows, u.n_cols, u.n_slices);
+  const Real s = 1.0 / h;
+
+  if (axis == 0) {
+    // Stencils run along the contiguous rows
+    const int lines = dims[1] * dims[2];
+
+#pragma omp parallel for schedule(static)
+    for (int q = 0; q < lines; ++q) {
+      const Real *x = u.memptr() + (uword)q * N;
+      Real *y = du.memptr() + (uword)q * N;
+
+      for (int i = 0; i < N; ++i) {
+        Stencil r = stencil(table, k, i, N);
+        Real sum = 0;
+        for (int c = 0; c <= k; ++c)
+          sum += (r.mirrored ? -r.w[k - c] : r.w[c]) * x[r.first + c];
+        y[i] = s * sum;
+      }
+    }
+    return;
+  }
+
+  // Each output line along x is a combination of k + 1 input lines
+  const uword len = dims[0];
+  const uword stride = axis == 1 ? dims[0] : dims[0] * dims[1];
+  const int outer = axis == 1 ? dims[2] : dims[1];
+  const uword outer_stride = axis == 1 ? dims[0] * dims[1] : dims[0];
+
+#pragma omp parallel for schedule(static)
+  for (int q = 0; q < outer * N; ++q) {
+    const int i = q % N, a = q / N;
+    const Real *x = u.memptr() + a * outer_stride;
+    Real *y = du.memptr() + a * outer_stride + i * stride;
+
+    Stencil r = stencil(table, k, i, N);
+    std::fill(y, y + len, 0.0);
+    for (int c = 0; c <= k; ++c) {
+      const Real w = s * (r.mirrored ? -r.w[k - c] : r.w[c]);
+      const Real *xl = x + (r.first + c) * stride;
+      for (uword p = 0; p < len; ++p)
+        y[p] += w * xl[p];
+    }
+  }
+}
+
+SidedNodal::SidedNodal(u32 m, Real dx, Type type) : sp_mat(m + 1, m + 1) {
+  assert(m >= 2);
+
+  // Neighbours of the end nodes through the periodic copy of node 0
+  for (u32 i = 0; i <= m; ++i) {
+    u32 left = i > 0 ? i - 1 : m - 1, right = i < m ? i + 1 : 1;
+    switch (type) {
+    case BACKWARD:
+      at(i, i) += 1 / dx;
+      at(i, left) -= 1 / dx;
+      break;
+    case FORWARD:
+      at(i, right) += 1 / dx;
+      at(i, i) -= 1 / dx;
+      break;
+    case CENTERED:
+      at(i, right) += 0.5 / dx;
+      at(i, left) -= 0.5 / dx;
+      break;
+    }
+  }
+}
+
+void SidedNodal::apply(const vec &u, vec &du, Real h, Type type) {
+  const uword m = u.n_elem - 1;
+  assert(m >= 2);
+  du.set_size(u.n_elem);
+
+  const Real *x = u.memptr();
+  Real *y = du.memptr();
+
+  auto left = [&](uword i) { return i > 0 ? x[i - 1] : x[m - 1]; };
+  auto right = [&](uword i) { return i < m ? x[i + 1] : x[1]; };
+
+  switch (type) {
+  case BACKWARD:
+    for (uword i = 0; i <= m; ++i)
+      y[i] = (x[i] - left(i)) / h;
+    break;
+  case FORWARD:
+    for (uword i = 0; i <= m; ++i)
+      y[i] = (right(i) - x[i]) / h;
+    break;
+  case CENTERED:
+    for (uword i = 0; i <= m; ++i)
+      y[i] = (right(i) - left(i)) / (2 * h);
+    break;
+  }
+}
@@ -0,0 +1,123 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file nodal.h
+ *
+ * @brief Nodal and sided nodal derivative operators
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef NODAL_H
+#define NODAL_H
+
+#include "utils.h"
+#include <vector>
+
+/**
+ * @brief Nodal derivative operator of order k, as in nodal.m
+ *
+ * Acts on the m + 1 nodes of m cells (the MATLAB functions take the
+ * number of nodes). Interior nodes use the centered stencil of k + 1
+ * nodes, the k/2 nodes next to each boundary the first or last k + 1
+ * nodes. The weights come from Mimetic::lagrange once per k, on first use,
+ * and are shared by all operators of that order.
+ */
+class Nodal : public sp_mat {
+
+public:
+  using sp_mat::operator=;
+
+  /**
+   * @brief 1-D Nodal Constructor
+   *
+   * @param k Order of accuracy
+   * @param m Number of cells
+   * @param dx Spacing between nodes
+   */
+  Nodal(u16 k, u32 m, Real dx);
+
+  /**
+   * @brief 2-D Nodal Constructor, the x- and y-derivatives stacked
+   *
+   * @param k Order of accuracy
+   * @param m Number of cells in x-direction
+   * @param n Number of cells in y-direction
+   * @param dx Spacing between nodes in x-direction
+   * @param dy Spacing between nodes in y-direction
+   */
+  Nodal(u16 k, u32 m, u32 n, Real dx, Real dy);
+
+  /**
+   * @brief 3-D Nodal Constructor, the x-, y- and z-derivatives stacked
+   *
+   * @param k Order of accuracy
+   * @param m Number of cells in x-direction
+   * @param n Number of cells in y-direction
+   * @param o Number of cells in z-direction
+   * @param dx Spacing between nodes in x-direction
+   * @param dy Spacing between nodes in y-direction
+   * @param dz Spacing between nodes in z-direction
+   */
+  Nodal(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz);
+
+  /**
+   * @brief Matrix-free derivative along one axis of node values
+   *
+   * @param k Order of accuracy
+   * @param u node values, x along rows, y along columns, z along slices
+   * @param du derivative, resized to u
+   * @param axis 0, 1 or 2 for x, y or z
+   * @param h Spacing between nodes along the axis
+   */
+  static void apply(u16 k, const cube &u, cube &du, u16 axis, Real h = 1.0);
+
+  /**
+   * @brief Weights of the k/2 boundary rows and of the interior row
+   *
+   * Row i < k/2 applies to the first k + 1 nodes, row k/2 to nodes
+   * i - k/2 ... i + k/2. Right boundary rows are the left ones reversed
+   * and negated. Computed on first use and cached.
+   */
+  static const std::vector<std::vector<Real>> &coefficients(u16 k);
+};
+
+/**
+ * @brief First-order or centered nodal derivative on a periodic grid, as
+ * in sidedNodal.m
+ *
+ * Nodes 0 and m coincide, so the stencils wrap around through nodes 1
+ * and m - 1.
+ */
+class SidedNodal : public sp_mat {
+
+public:
+  using sp_mat::operator=;
+
+  enum Type { BACKWARD, FORWARD, CENTERED };
+
+  /**
+   * @brief SidedNodal Constructor
+   *
+   * @param m Number of cells
+   * @param dx Spacing between nodes
+   * @param type Stencil, upwind for positive speeds if BACKWARD
+   */
+  SidedNodal(u32 m, Real dx, Type type = CENTERED);
+
+  /**
+   * @brief Matrix-free application to the m + 1 node values
+   *
+   * @param u node values
+   * @param du derivative, resized to u
+   * @param h Spacing between nodes
+   * @param type Stencil
+   */
+  static void apply(const vec &u, vec &du, Real h, Type type = CENTERED);
+};
+
+#endif // NODAL_H
@@ -0,0 +1,133 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file numa.cpp
+ *
+ * @brief First-touch placement of fields and operators on NUMA systems
+ *
+ * @date 2026/10/19
+ */
+
+#include "numa.h"
+#include <cassert>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+vec NUMA::zeros(uword n) {
+  vec y;
+  zeros(y, n);
+  return y;
+}
+
+void NUMA::zeros(vec &y, uword n) {
+  // set_size() only allocates, the pages are placed by the loop below
+  if (y.n_elem != n)
+    y.set_size(n);
+
+  Real *Y = y.memptr();
+#pragma omp parallel for schedule(static)
+  for (long long i = 0; i < (long long)n; ++i)
+    Y[i] = 0;
+}
+
+vec NUMA::copy(const vec &x) {
+  vec y(x.n_elem, fill::none);
+  const Real *X = x.memptr();
+  Real *Y = y.memptr();
+
+#pragma omp parallel for schedule(static)
+  for (long long i = 0; i < (long long)x.n_elem; ++i)
+    Y[i] = X[i];
+
+  return y;
+}
+
+int NUMA::node() {
+#if defined(__linux__) && defined(SYS_getcpu)
+  unsigned cpu = 0, node = 0;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0)
+    return node;
+#endif
+  return 0;
+}
+
+std::vector<int> NUMA::thread_nodes() {
+  int threads = 1;
+#ifdef _OPENMP
+  threads = omp_get_max_threads();
+#endif
+  std::vector<int> nodes(threads, 0);
+
+#pragma omp parallel num_threads(threads)
+  {
+    int t = 0;
+#ifdef _OPENMP
+    t = omp_get_thread_num();
+#endif
+    nodes[t] = node();
+  }
+
+  return nodes;
+}
+
+NumaMatrix::NumaMatrix(const sp_mat &A)
+    : rows(A.n_rows), cols(A.n_cols), nnz(A.n_nonzero) {
+  // Columns of the transpose are the rows of A
+  const sp_mat At = A.t();
+
+  // Not value-initialized, so the pages are untouched until the loop
+  ptr.reset(new uword[rows + 1]);
+  col.reset(new uword[nnz]);
+  val.reset(new Real[nnz]);
+
+  const uword *P = At.col_ptrs;
+  const uword *C = At.row_indices;
+  const Real *V = At.values;
+  uword *p = ptr.get(), *c = col.get();
+  Real *v = val.get();
+
+  p[0] = 0;
+#pragma omp parallel for schedule(static)
+  for (long long r = 0; r < (long long)rows; ++r) {
+    p[r + 1] = P[r + 1];
+    for (uword e = P[r]; e < P[r + 1]; ++e) {
+      c[e] = C[e];
+      v[e] = V[e];
+    }
+  }
+}
+
+void NumaMatrix::apply(const vec &x, vec &y) const {
+  assert(x.n_elem == cols);
+  if (y.n_elem != rows)
+    y.set_size(rows);
+
+  const uword *p = ptr.get(), *c = col.get();
+  const Real *v = val.get(), *X = x.memptr();
+  Real *Y = y.memptr();
+
+  // Same chunks as the constructor and NUMA::zeros(rows), 64-bit indices
+  // as rows may exceed 2^31
+#pragma omp parallel for schedule(static)
+  for (long long r = 0; r < (long long)rows; ++r) {
+    Real sum = 0;
+    for (uword e = p[r]; e < p[r + 1]; ++e)
+      sum += v[e] * X[c[e]];
+    Y[r] = sum;
+  }
+}
+
+Krylov::Operator NumaMatrix::op() const {
+  return [this](const vec &x, vec &y) { apply(x, y); };
+}
@@ -0,0 +1,111 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file numa.h
+ *
+ * @brief First-touch placement of fields and operators on NUMA systems
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef NUMA_H
+#define NUMA_H
+
+#include "krylov.h"
+#include "utils.h"
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Allocation of fields whose pages are spread over the NUMA nodes
+ * the way the OpenMP loops read them
+ *
+ * Linux puts a page on the node of the thread that first writes to it.
+ * Armadillo zero-fills and copies on the calling thread, so every page of
+ * a vector made that way lands on one socket and the threads of the other
+ * sockets stream it over the interconnect. Here storage is allocated
+ * without being written and then touched in an OpenMP loop with
+ * schedule(static) over the entries, which hands every thread the same
+ * contiguous range as the schedule(static) loop over rows of
+ * NumaMatrix::apply. MatrixFreeOperator places its own output, see
+ * apply().
+ *
+ * @note Placement only holds while threads stay on their socket, so pin
+ * them, e.g. OMP_PROC_BIND=spread OMP_PLACES=cores.
+ */
+class NUMA {
+public:
+  /**
+   * @brief n zeros, first touched by the threads that own them
+   */
+  static vec zeros(uword n);
+
+  /**
+   * @brief Sets y to n zeros, reallocated without being written if its
+   * size differs
+   */
+  static void zeros(vec &y, uword n);
+
+  /**
+   * @brief A copy of x placed as zeros()
+   */
+  static vec copy(const vec &x);
+
+  /**
+   * @brief NUMA node of the CPU running the calling thread, 0 if unknown
+   */
+  static int node();
+
+  /**
+   * @brief NUMA node of every OpenMP thread, by thread number
+   */
+  static std::vector<int> thread_nodes();
+};
+
+/**
+ * @brief Sparse matrix stored by rows and placed for y = A*x
+ *
+ * The rows are split in static chunks over the OpenMP threads. Every
+ * thread writes the row pointers, column indices and values of its rows
+ * when the matrix is built and its entries of y in apply(), so with pinned
+ * threads each one streams memory of its own node. Only x is read across
+ * nodes, at the columns of the rows owned.
+ */
+class NumaMatrix {
+public:
+  /**
+   * @brief NumaMatrix Constructor
+   *
+   * @param A a sparse matrix, copied
+   */
+  explicit NumaMatrix(const sp_mat &A);
+
+  /**
+   * @brief y = A*x, y first touched by row owner if resized
+   */
+  void apply(const vec &x, vec &y) const;
+
+  /**
+   * @brief The matrix as a Krylov::Operator, must outlive it
+   */
+  Krylov::Operator op() const;
+
+  /**
+   * @brief Number of rows, columns and nonzeros of the matrix
+   */
+  uword n_rows() const { return rows; }
+  uword n_cols() const { return cols; }
+  uword n_nonzero() const { return nnz; }
+
+private:
+  uword rows, cols, nnz;
+  std::unique_ptr<uword[]> ptr; // Row r holds entries ptr[r] to ptr[r + 1]
+  std::unique_ptr<uword[]> col;
+  std::unique_ptr<Real[]> val;
+};
+
+#endif // NUMA_H
@@ -0,0 +1,141 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file parareal.cpp
+ *
+ * @brief Parareal parallel-in-time driver
+ *
+ * @date 2026/10/19
+ */
+
+#include "parareal.h"
+#include <cassert>
+#include <chrono>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+static Real seconds_since(Clock::time_point start) {
+  return std::chrono::duration<Real>(Clock::now() - start).count();
+}
+
+Parareal::Parareal(const Propagator &coarse, const Propagator &fine,
+                   u32 slices, u32 threads)
+    : coarse(coarse), fine(fine), slices(slices), threads(threads) {
+  assert(slices > 0);
+
+#ifdef _OPENMP
+  if (this->threads == 0)
+    this->threads = omp_get_max_threads();
+#else
+  this->threads = 1;
+#endif
+}
+
+PararealInfo Parareal::solve(Real t0, Real tf, vec &u, Real tol, u32 maxit) {
+  assert(tf > t0);
+
+  if (maxit == 0 || maxit > slices)
+    maxit = slices;
+
+  PararealInfo info;
+  Clock::time_point start = Clock::now();
+
+  std::vector<Real> t(slices + 1);
+  for (u32 n = 0; n <= slices; ++n)
+    t[n] = t0 + (tf - t0) * n / slices;
+
+  // Initial guess from a serial coarse sweep
+  U.assign(slices + 1, u);
+  std::vector<vec> G(slices), F(slices);
+  std::vector<Real> fine_time(slices, 0);
+
+  Clock::time_point coarse_start = Clock::now();
+  for (u32 n = 0; n < slices; ++n) {
+    G[n] = U[n];
+    coarse(t[n], t[n + 1], G[n]);
+    U[n + 1] = G[n];
+  }
+  info.coarse_time += seconds_since(coarse_start);
+
+  for (u32 k = 0; k < maxit; ++k) {
+    // Fine solves of the slices not yet exact, concurrently
+#pragma omp parallel for schedule(dynamic) num_threads(threads)
+    for (int n = k; n < (int)slices; ++n) {
+      Clock::time_point slice_start = Clock::now();
+      F[n] = U[n];
+      fine(t[n], t[n + 1], F[n]);
+
+      // The first sweep covers every slice and gives the serial estimate
+      if (k == 0)
+        fine_time[n] = seconds_since(slice_start);
+    }
+
+    if (k == 0) {
+      for (Real s : fine_time)
+        info.serial_time += s;
+    }
+
+    // Serial coarse correction, slice k is exact after the fine solve
+    Real change = norm(F[k] - U[k + 1]) / std::max(norm(F[k]), 1e-300);
+    coarse_start = Clock::now();
+    U[k + 1] = F[k];
+
+    for (u32 n = k + 1; n < slices; ++n) {
+      vec g = U[n];
+      coarse(t[n], t[n + 1], g);
+
+      vec updated = g + F[n] - G[n];
+      Real scale = std::max(norm(updated), 1e-300);
+      change = std::max(change, norm(updated - U[n + 1]) / scale);
+
+      U[n + 1] = updated;
+      G[n] = g;
+    }
+    info.coarse_time += seconds_since(coarse_start);
+
+    PararealIteration iteration;
+    iteration.change = change;
+    iteration.elapsed = seconds_since(start);
+    iteration.speedup = info.serial_time / iteration.elapsed;
+    info.history.push_back(iteration);
+
+    // After one iteration per slice the fine solution is reproduced
+    if (change < tol || k + 1 == slices) {
+      info.converged = true;
+      break;
+    }
+  }
+
+  u = U[slices];
+  return info;
+}
+
+Parareal::Propagator Parareal::propagator(Integrator::Method method,
+                                          const Integrator::RHS &f, Real dt) {
+  return [method, f, dt](Real t0, Real t1, vec &u) {
+    // One integrator per call keeps concurrent calls independent
+    Integrator integrator(method, f);
+    u32 steps = std::max<u32>(1, std::ceil((t1 - t0) / dt - 1e-12));
+    Real h = (t1 - t0) / steps;
+
+    for (u32 s = 0; s < steps; ++s)
+      integrator.step(t0 + s * h, h, u);
+  };
+}
+
+Parareal::Propagator Parareal::coarsened(const Propagator &coarse,
+                                         const sp_mat &R, const sp_mat &P) {
+  return [coarse, R, P](Real t0, Real t1, vec &u) {
+    vec uc = R * u;
+    coarse(t0, t1, uc);
+    u = P * uc;
+  };
+}
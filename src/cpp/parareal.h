@@ -0,0 +1,117 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file parareal.h
+ *
+ * @brief Parareal parallel-in-time driver
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef PARAREAL_H
+#define PARAREAL_H
+
+#include "integrator.h"
+#include <vector>
+
+/**
+ * @brief Progress of one Parareal iteration
+ *
+ */
+struct PararealIteration {
+  Real change = 0;  ///< Largest relative update of a slice boundary value
+  Real elapsed = 0; ///< Wall time since the start of solve(), in seconds
+  Real speedup = 0; ///< Serial fine time / elapsed
+};
+
+/**
+ * @brief Convergence and timing report of a Parareal solve
+ *
+ */
+struct PararealInfo {
+  std::vector<PararealIteration> history; ///< One entry per iteration
+  Real serial_time = 0; ///< Estimated time of the fine propagator over
+                        ///< [t0, tf] on one thread, in seconds
+  Real coarse_time = 0; ///< Total time in the coarse propagator
+  bool converged = false; ///< True if the change fell below tol
+};
+
+/**
+ * @brief Parareal driver for u' = f(t, u) over [t0, tf]
+ *
+ * [t0, tf] is split into time slices. Each iteration runs the expensive
+ * fine propagator F on all slices concurrently (OpenMP threads), then
+ * corrects the slice boundary values serially with the cheap coarse
+ * propagator G:
+ *
+ *   U_{n+1} = G(U_n^new) + F(U_n^old) - G(U_n^old)
+ *
+ * After k iterations the first k slices match the serial fine solution, so
+ * the method converges in at most one iteration per slice. It is useful
+ * when it converges in few iterations and G is much cheaper than F, e.g. a
+ * coarser time step, a lower order k or a coarser grid (see coarsened()).
+ */
+class Parareal {
+public:
+  /**
+   * @brief Advances u in place from t0 to t1, must be reentrant
+   */
+  using Propagator = std::function<void(Real t0, Real t1, vec &u)>;
+
+  /**
+   * @brief Parareal constructor
+   *
+   * @param coarse cheap propagator G
+   * @param fine accurate propagator F, called concurrently
+   * @param slices number of time slices
+   * @param threads threads running F, the OpenMP default if zero
+   */
+  Parareal(const Propagator &coarse, const Propagator &fine, u32 slices,
+           u32 threads = 0);
+
+  /**
+   * @brief Solves from t0 to tf
+   *
+   * @param u initial condition on entry, solution at tf on exit
+   * @param tol tolerance on the relative change of the boundary values
+   * @param maxit maximum number of iterations, number of slices if zero
+   */
+  PararealInfo solve(Real t0, Real tf, vec &u, Real tol = 1e-8,
+                     u32 maxit = 0);
+
+  /**
+   * @brief Solution at the slice boundaries t0, ..., tf of the last solve
+   */
+  const std::vector<vec> &states() const { return U; }
+
+  /**
+   * @brief Propagator made of fixed steps of an explicit method
+   *
+   * @param method Runge-Kutta method
+   * @param f right hand side, must be reentrant
+   * @param dt largest step, each slice is split into equal steps
+   */
+  static Propagator propagator(Integrator::Method method,
+                               const Integrator::RHS &f, Real dt);
+
+  /**
+   * @brief Propagator on a coarser grid, u -> P G(R u)
+   *
+   * @param coarse propagator on the coarse grid
+   * @param R restriction from the fine to the coarse grid
+   * @param P prolongation from the coarse to the fine grid
+   */
+  static Propagator coarsened(const Propagator &coarse, const sp_mat &R,
+                              const sp_mat &P);
+
+private:
+  Propagator coarse, fine;
+  u32 slices, threads;
+  std::vector<vec> U; // Boundary values
+};
+
+#endif // PARAREAL_H
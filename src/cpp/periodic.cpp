@@ -0,0 +1,50 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file periodic.cpp
+ *
+ * @brief Matrix-free mimetic operators with periodic axes
+ *
+ * @date 2026/10/19
+ */
+
+#include "periodic.h"
+
+PeriodicGradient::PeriodicGradient(u16 k, u32 m, Real dx)
+    : MatrixFreeGradient(k, m, dx, true) {}
+
+PeriodicGradient::PeriodicGradient(u16 k, u32 m, u32 n, Real dx, Real dy,
+                                   bool px, bool py)
+    : MatrixFreeGradient(k, m, n, dx, dy, px, py) {}
+
+PeriodicGradient::PeriodicGradient(u16 k, u32 m, u32 n, u32 o, Real dx,
+                                   Real dy, Real dz, bool px, bool py, bool pz)
+    : MatrixFreeGradient(k, m, n, o, dx, dy, dz, px, py, pz) {}
+
+PeriodicDivergence::PeriodicDivergence(u16 k, u32 m, Real dx)
+    : MatrixFreeDivergence(k, m, dx, true) {}
+
+PeriodicDivergence::PeriodicDivergence(u16 k, u32 m, u32 n, Real dx, Real dy,
+                                       bool px, bool py)
+    : MatrixFreeDivergence(k, m, n, dx, dy, px, py) {}
+
+PeriodicDivergence::PeriodicDivergence(u16 k, u32 m, u32 n, u32 o, Real dx,
+                                       Real dy, Real dz, bool px, bool py,
+                                       bool pz)
+    : MatrixFreeDivergence(k, m, n, o, dx, dy, dz, px, py, pz) {}
+
+PeriodicLaplacian::PeriodicLaplacian(u16 k, u32 m, Real dx)
+    : MatrixFreeLaplacian(k, m, dx, true) {}
+
+PeriodicLaplacian::PeriodicLaplacian(u16 k, u32 m, u32 n, Real dx, Real dy,
+                                     bool px, bool py)
+    : MatrixFreeLaplacian(k, m, n, dx, dy, px, py) {}
+
+PeriodicLaplacian::PeriodicLaplacian(u16 k, u32 m, u32 n, u32 o, Real dx,
+                                     Real dy, Real dz, bool px, bool py,
+                                     bool pz)
+    : MatrixFreeLaplacian(k, m, n, o, dx, dy, dz, px, py, pz) {}
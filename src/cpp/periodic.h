@@ -0,0 +1,152 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file periodic.h
+ *
+ * @brief Matrix-free mimetic operators with periodic axes
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef PERIODIC_H
+#define PERIODIC_H
+
+#include "matrixfree.h"
+
+/**
+ * @brief Matrix-free mimetic Gradient, periodic along every axis unless
+ * flagged otherwise
+ */
+class PeriodicGradient : public MatrixFreeGradient {
+public:
+  /**
+   * @brief 1-D periodic Gradient
+   *
+   * @param k Order of accuracy
+   * @param m Number of cells
+   * @param dx Spacing between cells
+   */
+  PeriodicGradient(u16 k, u32 m, Real dx);
+
+  /**
+   * @brief 2-D Gradient, periodic along the flagged axes
+   *
+   * @param k Order of accuracy
+   * @param m Number of cells in x-direction
+   * @param n Number of cells in y-direction
+   * @param dx Spacing between cells in x-direction
+   * @param dy Spacing between cells in y-direction
+   * @param px, py Periodicity of each axis
+   */
+  PeriodicGradient(u16 k, u32 m, u32 n, Real dx, Real dy, bool px = true,
+                   bool py = true);
+
+  /**
+   * @brief 3-D Gradient, periodic along the flagged axes
+   *
+   * @param k Order of accuracy
+   * @param m Number of cells in x-direction
+   * @param n Number of cells in y-direction
+   * @param o Number of cells in z-direction
+   * @param dx Spacing between cells in x-direction
+   * @param dy Spacing between cells in y-direction
+   * @param dz Spacing between cells in z-direction
+   * @param px, py, pz Periodicity of each axis
+   */
+  PeriodicGradient(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz,
+                   bool px = true, bool py = true, bool pz = true);
+};
+
+/**
+ * @brief Matrix-free mimetic Divergence, periodic along every axis unless
+ * flagged otherwise
+ */
+class PeriodicDivergence : public MatrixFreeDivergence {
+public:
+  /**
+   * @brief 1-D periodic Divergence
+   *
+   * @param k Order of accuracy
+   * @param m Number of cells
+   * @param dx Spacing between cells
+   */
+  PeriodicDivergence(u16 k, u32 m, Real dx);
+
+  /**
+   * @brief 2-D Divergence, periodic along the flagged axes
+   *
+   * @param k Order of accuracy
+   * @param m Number of cells in x-direction
+   * @param n Number of cells in y-direction
+   * @param dx Spacing between cells in x-direction
+   * @param dy Spacing between cells in y-direction
+   * @param px, py Periodicity of each axis
+   */
+  PeriodicDivergence(u16 k, u32 m, u32 n, Real dx, Real dy, bool px = true,
+                     bool py = true);
+
+  /**
+   * @brief 3-D Divergence, periodic along the flagged axes
+   *
+   * @param k Order of accuracy
+   * @param m Number of cells in x-direction
+   * @param n Number of cells in y-direction
+   * @param o Number of cells in z-direction
+   * @param dx Spacing between cells in x-direction
+   * @param dy Spacing between cells in y-direction
+   * @param dz Spacing between cells in z-direction
+   * @param px, py, pz Periodicity of each axis
+   */
+  PeriodicDivergence(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz,
+                     bool px = true, bool py = true, bool pz = true);
+};
+
+/**
+ * @brief Matrix-free mimetic Laplacian, periodic along every axis unless
+ * flagged otherwise
+ */
+class PeriodicLaplacian : public MatrixFreeLaplacian {
+public:
+  /**
+   * @brief 1-D periodic Laplacian
+   *
+   * @param k Order of accuracy
+   * @param m Number of cells
+   * @param dx Spacing between cells
+   */
+  PeriodicLaplacian(u16 k, u32 m, Real dx);
+
+  /**
+   * @brief 2-D Laplacian, periodic along the flagged axes
+   *
+   * @param k Order of accuracy
+   * @param m Number of cells in x-direction
+   * @param n Number of cells in y-direction
+   * @param dx Spacing between cells in x-direction
+   * @param dy Spacing between cells in y-direction
+   * @param px, py Periodicity of each axis
+   */
+  PeriodicLaplacian(u16 k, u32 m, u32 n, Real dx, Real dy, bool px = true,
+                    bool py = true);
+
+  /**
+   * @brief 3-D Laplacian, periodic along the flagged axes
+   *
+   * @param k Order of accuracy
+   * @param m Number of cells in x-direction
+   * @param n Number of cells in y-direction
+   * @param o Number of cells in z-direction
+   * @param dx Spacing between cells in x-direction
+   * @param dy Spacing between cells in y-direction
+   * @param dz Spacing between cells in z-direction
+   * @param px, py, pz Periodicity of each axis
+   */
+  PeriodicLaplacian(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz,
+                    bool px = true, bool py = true, bool pz = true);
+};
+
+#endif // PERIODIC_H
@@ -0,0 +1,175 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file schwarz.cpp
+ *
+ * @brief Overlapping Schwarz domain decomposition preconditioner
+ *
+ * @date 2026/10/19
+ */
+
+#include "schwarz.h"
+#include <cassert>
+
+// First index of each of the parts contiguous ranges of 0..N-1, plus N
+static uvec splits(uword N, u32 parts) {
+  assert(parts > 0 && parts <= N);
+
+  uvec first(parts + 1);
+  for (u32 p = 0; p <= parts; ++p)
+    first(p) = p * N / parts;
+
+  return first;
+}
+
+// A(idx, idx) for a sorted idx, pos maps global to local indices (or -1)
+static sp_mat extract(const sp_mat &A, const uvec &idx, std::vector<sword> &pos) {
+  for (uword l = 0; l < idx.n_elem; ++l)
+    pos[idx(l)] = l;
+
+  std::vector<uword> rows, cols;
+  std::vector<Real> values;
+
+  for (uword l = 0; l < idx.n_elem; ++l) {
+    for (auto it = A.begin_col(idx(l)); it != A.end_col(idx(l)); ++it) {
+      if (pos[it.row()] >= 0) {
+        rows.push_back(pos[it.row()]);
+        cols.push_back(l);
+        values.push_back(*it);
+      }
+    }
+  }
+
+  for (uword l = 0; l < idx.n_elem; ++l)
+    pos[idx(l)] = -1;
+
+  umat locations(2, values.size());
+  for (uword v = 0; v < values.size(); ++v) {
+    locations(0, v) = rows[v];
+    locations(1, v) = cols[v];
+  }
+
+  return sp_mat(locations, vec(values), idx.n_elem, idx.n_elem);
+}
+
+Schwarz::Schwarz(const sp_mat &A, const std::vector<uvec> &owned,
+                 u32 overlap, Type type, const std::string &backend)
+    : type(type), owned(owned) {
+  assert(A.n_rows == A.n_cols);
+
+  uword N = A.n_rows;
+  uword S = owned.size();
+
+  // Neighbors in either direction of the matrix graph
+  sp_mat P = spones(A);
+  sp_mat Pt = P.t();
+
+  domains.resize(S);
+  owned_local.resize(S);
+  work.resize(S);
+
+  for (uword s = 0; s < S; ++s) {
+    vec mask(N, fill::zeros);
+    mask.elem(owned[s]).ones();
+
+    for (u32 layer = 0; layer < overlap; ++layer)
+      mask += P * mask + Pt * mask;
+
+    domains[s] = find(mask);
+
+    // Positions of the owned unknowns inside the sorted subdomain
+    uvec sorted = sort(owned[s]);
+    owned_local[s].set_size(sorted.n_elem);
+    uword l = 0;
+    for (uword i = 0; i < sorted.n_elem; ++i) {
+      while (domains[s](l) != sorted(i))
+        ++l;
+      owned_local[s](i) = l;
+    }
+    this->owned[s] = sorted;
+
+    solvers.push_back(LinearSolver::create(backend));
+  }
+
+  update(A);
+}
+
+void Schwarz::update(const sp_mat &A) {
+  std::vector<sword> pos(A.n_rows, -1);
+  std::vector<sp_mat> local(domains.size());
+
+  for (uword s = 0; s < domains.size(); ++s)
+    local[s] = extract(A, domains[s], pos);
+
+#pragma omp parallel for schedule(dynamic)
+  for (int s = 0; s < (int)domains.size(); ++s)
+    solvers[s]->factorise(local[s]);
+}
+
+void Schwarz::apply(const vec &r, vec &z) {
+  z.zeros(r.n_elem);
+
+#pragma omp parallel for schedule(dynamic)
+  for (int s = 0; s < (int)domains.size(); ++s) {
+    work[s] = solvers[s]->solve(r.elem(domains[s]));
+
+    // Owned sets are disjoint, so the threads write distinct entries
+    if (type == RESTRICTED)
+      z.elem(owned[s]) = work[s].elem(owned_local[s]);
+  }
+
+  if (type == ADDITIVE) {
+    for (uword s = 0; s < domains.size(); ++s)
+      z.elem(domains[s]) += work[s];
+  }
+}
+
+Krylov::Operator Schwarz::preconditioner() {
+  return [this](const vec &r, vec &z) { apply(r, z); };
+}
+
+std::vector<uvec> Schwarz::blocks(uword N, u32 parts) {
+  uvec first = splits(N, parts);
+  std::vector<uvec> owned(parts);
+
+  for (u32 p = 0; p < parts; ++p)
+    owned[p] = regspace<uvec>(first(p), first(p + 1) - 1);
+
+  return owned;
+}
+
+std::vector<uvec> Schwarz::boxes(u32 m, u32 n, u32 px, u32 py) {
+  return boxes(m, n, 0, px, py, 1);
+}
+
+std::vector<uvec> Schwarz::boxes(u32 m, u32 n, u32 o, u32 px, u32 py,
+                                 u32 pz) {
+  // o = 0 with pz = 1 describes a 2-D grid, a single layer in z
+  uword nx = m + 2, ny = n + 2, nz = o ? o + 2 : 1;
+  uvec fx = splits(nx, px), fy = splits(ny, py), fz = splits(nz, pz);
+
+  std::vector<uvec> owned;
+
+  for (u32 c = 0; c < pz; ++c) {
+    for (u32 b = 0; b < py; ++b) {
+      for (u32 a = 0; a < px; ++a) {
+        uvec box((fx(a + 1) - fx(a)) * (fy(b + 1) - fy(b)) *
+                 (fz(c + 1) - fz(c)));
+        uword id = 0;
+
+        for (uword l = fz(c); l < fz(c + 1); ++l)
+          for (uword j = fy(b); j < fy(b + 1); ++j)
+            for (uword i = fx(a); i < fx(a + 1); ++i)
+              box(id++) = (l * ny + j) * nx + i;
+
+        owned.push_back(box);
+      }
+    }
+  }
+
+  return owned;
+}
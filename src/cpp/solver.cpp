@@ -0,0 +1,468 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file solver.cpp
+ *
+ * @brief Sparse linear solver backends selectable at runtime
+ *
+ * @date 2026/10/19
+ */
+
+#include "solver.h"
+#include "schwarz.h"
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <eigen3/Eigen/SparseCholesky>
+#include <eigen3/Eigen/SparseLU>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+Real seconds_since(Clock::time_point start) {
+  return std::chrono::duration<Real>(Clock::now() - start).count();
+}
+
+template <typename T = Real>
+Eigen::SparseMatrix<T> to_eigen(const sp_mat &A) {
+  Eigen::SparseMatrix<T> eigen_A(A.n_rows, A.n_cols);
+  std::vector<Eigen::Triplet<T>> triplets;
+  triplets.reserve(A.n_nonzero);
+
+  for (auto it = A.begin(); it != A.end(); ++it)
+    triplets.push_back(Eigen::Triplet<T>(it.row(), it.col(), T(*it)));
+
+  eigen_A.setFromTriplets(triplets.begin(), triplets.end());
+
+  return eigen_A;
+}
+
+#ifdef ARMA_USE_SUPERLU
+class SuperLUSolver : public LinearSolver {
+protected:
+  void setup(const sp_mat &A) override {
+    if (!factoriser.factorise(A))
+      throw std::runtime_error("superlu: factorisation failed");
+  }
+
+  void apply(const vec &b, vec &x) override {
+    if (!factoriser.solve(x, b))
+      throw std::runtime_error("superlu: solve failed");
+  }
+
+  // SuperLU solves all the columns in one call
+  void apply_block(const mat &B, mat &X) override {
+    if (!factoriser.solve(X, B))
+      throw std::runtime_error("superlu: solve failed");
+  }
+
+private:
+  // The L and U factors are private to spsolve_factoriser, so fill and
+  // bytes stay zero
+  spsolve_factoriser factoriser;
+};
+#endif
+
+class EigenLUSolver : public LinearSolver {
+protected:
+  void setup(const sp_mat &A) override {
+    Eigen::SparseMatrix<Real> eigen_A = to_eigen(A);
+
+    solver.analyzePattern(eigen_A);
+    solver.factorize(eigen_A);
+    if (solver.info() != Eigen::Success)
+      throw std::runtime_error("eigen-lu: " + solver.lastErrorMessage());
+
+    info.fill = solver.nnzL() + solver.nnzU();
+    info.bytes = info.fill * (sizeof(Real) + sizeof(int));
+  }
+
+  void apply(const vec &b, vec &x) override {
+    x.set_size(b.n_elem);
+    Eigen::Map<const Eigen::VectorXd> eigen_b(b.memptr(), b.n_elem);
+    Eigen::Map<Eigen::VectorXd> eigen_x(x.memptr(), x.n_elem);
+    eigen_x = solver.solve(eigen_b);
+  }
+
+  void apply_block(const mat &B, mat &X) override {
+    X.set_size(B.n_rows, B.n_cols);
+    Eigen::Map<const Eigen::MatrixXd> eigen_B(B.memptr(), B.n_rows, B.n_cols);
+    Eigen::Map<Eigen::MatrixXd> eigen_X(X.memptr(), X.n_rows, X.n_cols);
+    eigen_X = solver.solve(eigen_B);
+  }
+
+  bool concurrent() const override { return true; }
+
+private:
+  Eigen::SparseLU<Eigen::SparseMatrix<Real>, Eigen::COLAMDOrdering<int>> solver;
+};
+
+class EigenLDLTSolver : public LinearSolver {
+protected:
+  void setup(const sp_mat &A) override {
+    solver.compute(to_eigen(A));
+    if (solver.info() != Eigen::Success)
+      throw std::runtime_error("eigen-ldlt: factorisation failed");
+
+    info.fill = solver.matrixL().nestedExpression().nonZeros() + A.n_rows;
+    info.bytes = info.fill * (sizeof(Real) + sizeof(int));
+  }
+
+  void apply(const vec &b, vec &x) override {
+    x.set_size(b.n_elem);
+    Eigen::Map<const Eigen::VectorXd> eigen_b(b.memptr(), b.n_elem);
+    Eigen::Map<Eigen::VectorXd> eigen_x(x.memptr(), x.n_elem);
+    eigen_x = solver.solve(eigen_b);
+  }
+
+  void apply_block(const mat &B, mat &X) override {
+    X.set_size(B.n_rows, B.n_cols);
+    Eigen::Map<const Eigen::MatrixXd> eigen_B(B.memptr(), B.n_rows, B.n_cols);
+    Eigen::Map<Eigen::MatrixXd> eigen_X(X.memptr(), X.n_rows, X.n_cols);
+    eigen_X = solver.solve(eigen_B);
+  }
+
+  bool concurrent() const override { return true; }
+
+private:
+  Eigen::SimplicialLDLT<Eigen::SparseMatrix<Real>> solver;
+};
+
+// Single precision LU refined in double precision. Each step solves
+// A d = r with the float factors and updates x += d, r = b - Ax in double,
+// so the error shrinks by about cond(A) * eps_float per step. If that is not
+// below one the refinement stagnates and GMRES, preconditioned with the same
+// float factors, finishes the solve.
+class MixedPrecisionSolver : public LinearSolver {
+public:
+  explicit MixedPrecisionSolver(const SolverOptions &opts) : opts(opts) {}
+
+protected:
+  void setup(const sp_mat &A) override {
+    this->A = A;
+    Eigen::SparseMatrix<float> eigen_A = to_eigen<float>(A);
+
+    solver.analyzePattern(eigen_A);
+    solver.factorize(eigen_A);
+    if (solver.info() != Eigen::Success)
+      throw std::runtime_error("mixed: " + solver.lastErrorMessage());
+
+    info.fill = solver.nnzL() + solver.nnzU();
+    info.bytes = info.fill * (sizeof(float) + sizeof(int));
+  }
+
+  void apply(const vec &b, vec &x) override {
+    uword N = b.n_elem;
+    u32 maxit = opts.maxit ? opts.maxit : N;
+
+    x.zeros(N);
+    vec r = b;
+    vec d(N);
+
+    Real bnorm = norm(b);
+    Real previous = 0;
+    info.iterations = 0;
+    info.residual = 0;
+
+    if (bnorm == 0)
+      return;
+
+    while (true) {
+      info.residual = norm(r) / bnorm;
+
+      if (info.residual <= opts.tol || info.iterations >= maxit)
+        return;
+
+      // Refinement is not contracting, let GMRES take over
+      if (info.iterations > 0 && info.residual > 0.5 * previous)
+        break;
+
+      previous = info.residual;
+
+      correct(r, d);
+      x += d;
+      r = b - A * x;
+      ++info.iterations;
+    }
+
+    KrylovInfo report = Krylov::gmres(
+        Krylov::op(A), b, x, [this](const vec &r, vec &d) { correct(r, d); },
+        opts.tol, maxit - info.iterations, opts.restart);
+
+    info.iterations += report.iterations;
+    info.residual = report.residual;
+  }
+
+private:
+  // d = A^-1 r with the single precision factors
+  void correct(const vec &r, vec &d) {
+    d.set_size(r.n_elem);
+    Eigen::Map<const Eigen::VectorXd> eigen_r(r.memptr(), r.n_elem);
+    Eigen::Map<Eigen::VectorXd> eigen_d(d.memptr(), d.n_elem);
+
+    rf = eigen_r.cast<float>();
+    df = solver.solve(rf);
+    eigen_d = df.cast<Real>();
+  }
+
+  SolverOptions opts;
+  sp_mat A;
+  Eigen::SparseLU<Eigen::SparseMatrix<float>, Eigen::COLAMDOrdering<int>>
+      solver;
+  Eigen::VectorXf rf, df;
+};
+
+class KrylovSolver : public LinearSolver {
+public:
+  enum Method { CG, BICGSTAB, GMRES };
+
+  KrylovSolver(Method method, const SolverOptions &opts)
+      : method(method), opts(opts) {}
+
+protected:
+  void setup(const sp_mat &A) override {
+    this->A = A;
+    op = Krylov::op(this->A);
+    M = Krylov::jacobi(this->A);
+  }
+
+  void apply(const vec &b, vec &x) override {
+    KrylovInfo report;
+    x.reset();
+
+    switch (method) {
+    case CG:
+      report = Krylov::cg(op, b, x, M, opts.tol, opts.maxit);
+      break;
+    case BICGSTAB:
+      report = Krylov::bicgstab(op, b, x, M, opts.tol, opts.maxit);
+      break;
+    case GMRES:
+      report = Krylov::gmres(op, b, x, M, opts.tol, opts.maxit, opts.restart);
+      break;
+    }
+
+    info.iterations = report.iterations;
+    info.residual = report.residual;
+  }
+
+private:
+  Method method;
+  SolverOptions opts;
+  sp_mat A;
+  Krylov::Operator op;
+  Krylov::Operator M;
+};
+
+// GMRES preconditioned by restricted additive Schwarz on contiguous blocks,
+// which are slabs of the lexicographically ordered grid
+class SchwarzSolver : public LinearSolver {
+public:
+  explicit SchwarzSolver(const SolverOptions &opts) : opts(opts) {}
+
+protected:
+  void setup(const sp_mat &A) override {
+    u32 parts = opts.subdomains;
+#ifdef _OPENMP
+    if (parts == 0)
+      parts = omp_get_max_threads();
+#endif
+    parts = std::max(1u, std::min<u32>(parts, A.n_rows));
+
+    this->A = A;
+    op = Krylov::op(this->A);
+    M.reset(new Schwarz(this->A, Schwarz::blocks(A.n_rows, parts),
+                        opts.overlap, Schwarz::RESTRICTED, "eigen-lu"));
+  }
+
+  void apply(const vec &b, vec &x) override {
+    x.reset();
+    KrylovInfo report = Krylov::gmres(op, b, x, M->preconditioner(), opts.tol,
+                                      opts.maxit, opts.restart);
+
+    info.iterations = report.iterations;
+    info.residual = report.residual;
+  }
+
+private:
+  SolverOptions opts;
+  sp_mat A;
+  Krylov::Operator op;
+  std::unique_ptr<Schwarz> M;
+};
+
+template <typename T> LinearSolver::Factory direct() {
+  return [](const SolverOptions &) {
+    return std::unique_ptr<LinearSolver>(new T);
+  };
+}
+
+template <typename T> LinearSolver::Factory with_options() {
+  return [](const SolverOptions &opts) {
+    return std::unique_ptr<LinearSolver>(new T(opts));
+  };
+}
+
+LinearSolver::Factory krylov(KrylovSolver::Method method) {
+  return [method](const SolverOptions &opts) {
+    return std::unique_ptr<LinearSolver>(new KrylovSolver(method, opts));
+  };
+}
+
+std::map<std::string, LinearSolver::Factory> &registry() {
+  static std::map<std::string, LinearSolver::Factory> backends = {
+#ifdef ARMA_USE_SUPERLU
+      {"superlu", direct<SuperLUSolver>()},
+#endif
+      {"eigen-lu", direct<EigenLUSolver>()},
+      {"eigen-ldlt", direct<EigenLDLTSolver>()},
+      {"mixed", with_options<MixedPrecisionSolver>()},
+      {"cg", krylov(KrylovSolver::CG)},
+      {"bicgstab", krylov(KrylovSolver::BICGSTAB)},
+      {"gmres", krylov(KrylovSolver::GMRES)},
+      {"schwarz", with_options<SchwarzSolver>()},
+  };
+
+  return backends;
+}
+
+} // namespace
+
+void LinearSolver::factorise(const sp_mat &A) {
+  assert(A.n_rows == A.n_cols);
+
+  info = SolverStats();
+
+  auto start = Clock::now();
+  setup(A);
+  info.setup_time = seconds_since(start);
+}
+
+vec LinearSolver::solve(const vec &b) {
+  vec x;
+
+  auto start = Clock::now();
+  apply(b, x);
+  info.solve_time = seconds_since(start);
+
+  return x;
+}
+
+void LinearSolver::solve(const mat &B, mat &X, u32 block) {
+  auto start = Clock::now();
+
+  if (!concurrent()) {
+    apply_block(B, X);
+    info.solve_time = seconds_since(start);
+    return;
+  }
+
+  uword cols = B.n_cols;
+  int threads = 1;
+#ifdef _OPENMP
+  threads = omp_get_max_threads();
+#endif
+
+  if (block == 0)
+    block = std::max<uword>(1, (cols + threads - 1) / threads);
+
+  int blocks = (cols + block - 1) / block;
+  X.set_size(B.n_rows, cols);
+
+#pragma omp parallel for schedule(dynamic)
+  for (int k = 0; k < blocks; ++k) {
+    uword first = k * block;
+    uword last = std::min<uword>(first + block, cols) - 1;
+
+    mat Bk = B.cols(first, last);
+    mat Xk;
+    apply_block(Bk, Xk);
+    X.cols(first, last) = Xk;
+  }
+
+  info.solve_time = seconds_since(start);
+}
+
+void LinearSolver::apply_block(const mat &B, mat &X) {
+  X.set_size(B.n_rows, B.n_cols);
+  vec b, x;
+  u32 iterations = 0;
+  Real residual = 0;
+
+  for (uword c = 0; c < B.n_cols; ++c) {
+    b = B.col(c);
+    apply(b, x);
+    X.col(c) = x;
+
+    // Report the worst column
+    iterations = std::max(iterations, info.iterations);
+    residual = std::max(residual, info.residual);
+  }
+
+  info.iterations = iterations;
+  info.residual = residual;
+}
+
+std::unique_ptr<LinearSolver> LinearSolver::create(const std::string &name,
+                                                   const SolverOptions &opts) {
+  auto it = registry().find(name);
+
+  if (it == registry().end())
+    throw std::invalid_argument("Unknown linear solver backend: " + name);
+
+  return it->second(opts);
+}
+
+void LinearSolver::add(const std::string &name, Factory factory) {
+  registry()[name] = factory;
+}
+
+std::vector<std::string> LinearSolver::backends() {
+  std::vector<std::string> names;
+
+  for (const auto &backend : registry())
+    names.push_back(backend.first);
+
+  return names;
+}
+
+std::string LinearSolver::default_backend() {
+  const char *name = std::getenv("MOLE_SOLVER");
+
+  if (name)
+    return name;
+
+#ifdef EIGEN
+  return "eigen-lu";
+#else
+  return "superlu";
+#endif
+}
+
+vec LinearSolver::spsolve(const sp_mat &A, const vec &b,
+                          const std::string &name) {
+  std::unique_ptr<LinearSolver> solver = create(name);
+  solver->factorise(A);
+
+  return solver->solve(b);
+}
+
+void LinearSolver::spsolve(const sp_mat &A, const mat &B, mat &X,
+                           const std::string &name) {
+  std::unique_ptr<LinearSolver> solver = create(name);
+  solver->factorise(A);
+  solver->solve(B, X);
+}
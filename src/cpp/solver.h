@@ -0,0 +1,187 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file solver.h
+ *
+ * @brief Sparse linear solver backends selectable at runtime
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include "krylov.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Timings and work of a linear solver backend
+ *
+ */
+struct SolverStats {
+  Real setup_time = 0; ///< Seconds spent in factorise()
+  Real solve_time = 0; ///< Seconds spent in the last solve()
+  u32 iterations = 0;  ///< Iterations of the last solve, zero if direct
+  Real residual = 0;   ///< Relative residual of the last solve, if iterative
+  uword fill = 0;      ///< Nonzeros of the factors, zero if not reported
+                       ///< ("superlu", the Krylov backends and "schwarz")
+  uword bytes = 0;     ///< Approximate size of the factors, zero if not reported
+};
+
+/**
+ * @brief Options of the iterative backends
+ *
+ */
+struct SolverOptions {
+  Real tol = 1e-10;   ///< Relative residual tolerance
+  u32 maxit = 0;      ///< Maximum number of iterations (or refinement steps),
+                      ///< system size if zero
+  u32 restart = 30;   ///< GMRES restart length
+  u32 subdomains = 0; ///< Schwarz subdomains, number of threads if zero
+  u32 overlap = 2;    ///< Schwarz overlap, in layers of matrix neighbors
+};
+
+/**
+ * @brief Common interface of the sparse linear solver backends
+ *
+ * A backend is created by name, factorises A once and then solves any number
+ * of right hand sides. The built-in backends are
+ *
+ * - "superlu"    Armadillo + SuperLU LU factorization, fill and bytes are
+ *                not reported (Armadillo keeps the factors private)
+ * - "eigen-lu"   Eigen SparseLU
+ * - "eigen-ldlt" Eigen SimplicialLDLT, A must be symmetric
+ * - "mixed"      Single precision Eigen SparseLU + double precision iterative
+ *                refinement, half the factor memory of "eigen-lu"
+ * - "cg"         Jacobi preconditioned Conjugate Gradient, A must be SPD
+ * - "bicgstab"   Jacobi preconditioned BiCGSTAB
+ * - "gmres"      Jacobi preconditioned restarted GMRES
+ * - "schwarz"    GMRES preconditioned by restricted additive Schwarz, local
+ *                subdomains factorised in parallel
+ *
+ * and more can be registered with add().
+ */
+class LinearSolver {
+public:
+  /**
+   * @brief Creates a backend with the given options
+   */
+  using Factory =
+      std::function<std::unique_ptr<LinearSolver>(const SolverOptions &)>;
+
+  virtual ~LinearSolver() = default;
+
+  /**
+   * @brief Analyzes and factorises A, or sets up the preconditioner
+   *
+   * @param A a square sparse matrix
+   */
+  void factorise(const sp_mat &A);
+
+  /**
+   * @brief Solves Ax = b with the factorised A
+   *
+   * @param b RHS of Ax=b
+   */
+  vec solve(const vec &b);
+
+  /**
+   * @brief Solves AX = B for many right hand sides with the factorised A
+   *
+   * Backends that support it solve blocks of columns at once, with the
+   * blocks in parallel (OpenMP); the others go column by column.
+   *
+   * @param B right hand sides, one per column
+   * @param X solutions, one per column
+   * @param block columns per block, columns / threads if zero
+   */
+  void solve(const mat &B, mat &X, u32 block = 0);
+
+  /**
+   * @brief Timings and work of the last factorise() and solve()
+   */
+  const SolverStats &stats() const { return info; }
+
+  /**
+   * @brief Creates a registered backend
+   *
+   * @param name backend name, see backends()
+   * @param opts options of the iterative backends
+   */
+  static std::unique_ptr<LinearSolver>
+  create(const std::string &name, const SolverOptions &opts = SolverOptions());
+
+  /**
+   * @brief Registers a new backend, replacing any with the same name
+   *
+   * @param name backend name
+   * @param factory creates the backend
+   */
+  static void add(const std::string &name, Factory factory);
+
+  /**
+   * @brief Names of the registered backends
+   */
+  static std::vector<std::string> backends();
+
+  /**
+   * @brief Backend used when none is named
+   *
+   * The MOLE_SOLVER environment variable if set, otherwise "eigen-lu" when
+   * built with EIGEN and "superlu" when not.
+   */
+  static std::string default_backend();
+
+  /**
+   * @brief One-shot factorise and solve, replaces Armadillo's spsolve
+   *
+   * @param A a square sparse matrix
+   * @param b RHS of Ax=b
+   * @param name backend name
+   */
+  static vec spsolve(const sp_mat &A, const vec &b,
+                     const std::string &name = default_backend());
+
+  /**
+   * @brief One-shot factorise and solve for many right hand sides
+   *
+   * @param A a square sparse matrix
+   * @param B right hand sides, one per column
+   * @param X solutions, one per column
+   * @param name backend name
+   */
+  static void spsolve(const sp_mat &A, const mat &B, mat &X,
+                      const std::string &name = default_backend());
+
+protected:
+  /**
+   * @brief Backend specific factorization, fills info.fill
+   */
+  virtual void setup(const sp_mat &A) = 0;
+
+  /**
+   * @brief Backend specific solve, fills info.iterations and info.residual
+   */
+  virtual void apply(const vec &b, vec &x) = 0;
+
+  /**
+   * @brief Backend specific solve of a block of columns, column by column
+   * unless overridden
+   */
+  virtual void apply_block(const mat &B, mat &X);
+
+  /**
+   * @brief True if apply_block() may run concurrently on disjoint blocks
+   */
+  virtual bool concurrent() const { return false; }
+
+  SolverStats info;
+};
+
+#endif // SOLVER_H
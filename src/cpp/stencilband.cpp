@@ -0,0 +1,111 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file stencilband.cpp
+ *
+ * @brief Banded rows of a 1-D operator for matrix-free application
+ *
+ * @date 2026/10/19
+ */
+
+#include "stencilband.h"
+#include <algorithm>
+#include <utility>
+
+StencilBand::StencilBand(const sp_mat &A, bool periodic)
+    : N(A.n_rows), cols(A.n_cols), periodic(periodic) {
+  sp_mat At = A.t();
+
+  if (periodic) {
+    // Every row is the middle one, offsets wrapped to the nearest image
+    uword mid = N / 2;
+    std::vector<std::pair<int, Real>> entries;
+    for (auto it = At.begin_col(mid); it != At.end_col(mid); ++it) {
+      int o = (int)it.row() - (int)mid;
+      if (o >= (int)N / 2)
+        o -= N;
+      else if (o < -(int)N / 2)
+        o += N;
+      entries.push_back({o, *it});
+    }
+
+    first = 0;
+    int last = 0;
+    for (auto &e : entries) {
+      first = std::min(first, e.first);
+      last = std::max(last, e.first);
+    }
+    stencil.assign(last - first + 1, 0.0);
+    for (auto &e : entries)
+      stencil[e.first - first] = e.second;
+    reach = std::max(-first, last);
+    return;
+  }
+
+  Real tol = 1e-14 * abs(At).max();
+
+  // Every row as its first column and dense weights, tiny values dropped
+  std::vector<int> firsts(N);
+  std::vector<std::vector<Real>> dense(N);
+
+  for (uword i = 0; i < N; ++i) {
+    int lo = cols, hi = -1;
+    for (auto it = At.begin_col(i); it != At.end_col(i); ++it) {
+      if (std::abs(*it) > tol) {
+        lo = std::min<int>(lo, it.row());
+        hi = std::max<int>(hi, it.row());
+      }
+    }
+
+    firsts[i] = hi < 0 ? i : lo;
+    if (hi >= 0) {
+      dense[i].assign(hi - lo + 1, 0.0);
+      for (auto it = At.begin_col(i); it != At.end_col(i); ++it)
+        if (std::abs(*it) > tol)
+          dense[i][it.row() - lo] = *it;
+
+      reach = std::max<int>(reach, std::max<int>(i - lo, hi - i));
+    }
+  }
+
+  // Interior stencil from the middle row
+  uword mid = N / 2;
+  first = firsts[mid] - (int)mid;
+  stencil = dense[mid];
+
+  auto interior = [&](uword i) {
+    if (firsts[i] - (int)i != first || dense[i].size() != stencil.size())
+      return false;
+    for (size_t c = 0; c < stencil.size(); ++c)
+      if (std::abs(dense[i][c] - stencil[c]) > 1e-12 * std::abs(stencil[c]) + tol)
+        return false;
+    return true;
+  };
+
+  lo = 0;
+  while (lo < N && !interior(lo))
+    ++lo;
+  hi = 0;
+  while (hi < N - lo && !interior(N - 1 - hi))
+    ++hi;
+
+  // Too few cells for an interior, keep every row
+  for (uword i = lo; i < N - hi; ++i) {
+    if (!interior(i)) {
+      lo = N;
+      hi = 0;
+      break;
+    }
+  }
+
+  for (uword i = 0; i < N; ++i) {
+    if (i < lo || i >= N - hi) {
+      row_first.push_back(firsts[i]);
+      rows.push_back(dense[i]);
+    }
+  }
+}
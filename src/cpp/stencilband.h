@@ -0,0 +1,74 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file stencilband.h
+ *
+ * @brief Banded rows of a 1-D operator for matrix-free application
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef STENCILBAND_H
+#define STENCILBAND_H
+
+#include "utils.h"
+#include <vector>
+
+/**
+ * @brief A 1-D operator as its interior stencil plus the boundary rows that
+ * differ from it
+ *
+ * The rows are extracted from the assembled operator with tiny values
+ * dropped, so any order k keeps its exact boundary rows and the storage
+ * does not grow with the grid. A periodic (circulant) operator is all
+ * stencil, and its columns are to be wrapped around by the caller.
+ */
+struct StencilBand {
+  uword N = 0;                ///< Number of rows, 0 for no operator
+  uword cols = 0;             ///< Number of columns
+  bool periodic = false;      ///< Circulant, every row the stencil
+  int reach = 0;              ///< max |col - row| over all rows
+  int first = 0;              ///< Offset of the first interior weight
+  std::vector<Real> stencil;  ///< Interior weights
+  uword lo = 0, hi = 0;       ///< Rows [0, lo) and [N - hi, N) are explicit
+  std::vector<int> row_first; ///< First column of every explicit row
+  std::vector<std::vector<Real>> rows; ///< Weights of every explicit row
+
+  StencilBand() = default;
+
+  /**
+   * @brief StencilBand Constructor
+   *
+   * @param A a 1-D operator, banded away from its boundary rows
+   * @param periodic True if A is circulant, its middle row is then the
+   * stencil
+   */
+  StencilBand(const sp_mat &A, bool periodic = false);
+
+  /**
+   * @brief Row i as its first column and weights
+   */
+  void row(uword i, int &col, const Real *&w, int &count) const {
+    uword band;
+    if (i < lo)
+      band = i;
+    else if (i >= N - hi)
+      band = lo + i - (N - hi);
+    else {
+      col = i + first;
+      w = stencil.data();
+      count = stencil.size();
+      return;
+    }
+
+    col = row_first[band];
+    w = rows[band].data();
+    count = rows[band].size();
+  }
+};
+
+#endif // STENCILBAND_H
@@ -0,0 +1,100 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file stencillaplacian.h
+ *
+ * @brief Matrix-free mimetic Laplacian with temporally blocked diffusion
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef STENCILLAPLACIAN_H
+#define STENCILLAPLACIAN_H
+
+#include "matrixfree.h"
+
+/**
+ * @brief Explicit diffusion on the matrix-free Laplacian
+ *
+ * A MatrixFreeLaplacian with walls on every axis, applied by its kernel
+ * (apply(), set_tiles() and autotune() included), that also takes
+ * explicit Euler steps u += dt*L*u.
+ *
+ * diffuse() blocks the steps in time by wavefronts: the grid is cut into
+ * slabs of planes along the slowest axis, and each wavefront advances step
+ * 1 on a slab, step 2 on the slab behind it, and so on for depth steps.
+ * The slabs of a wavefront are close together, so every step finds its
+ * input in cache instead of streaming the whole field, and nothing is
+ * computed twice. Two fields hold all the steps, step r writing over step
+ * r - 2 once it is no longer read. The lines of a slab are split over the
+ * threads (OpenMP).
+ */
+class StencilLaplacian : public MatrixFreeLaplacian {
+public:
+  /**
+   * @brief 1-D matrix-free Laplacian
+   *
+   * @param k Order of accuracy
+   * @param m Number of cells
+   * @param dx Spacing between cells
+   */
+  StencilLaplacian(u16 k, u32 m, Real dx);
+
+  /**
+   * @brief 2-D matrix-free Laplacian
+   *
+   * @param k Order of accuracy
+   * @param m Number of cells in x-direction
+   * @param n Number of cells in y-direction
+   * @param dx Spacing between cells in x-direction
+   * @param dy Spacing between cells in y-direction
+   */
+  StencilLaplacian(u16 k, u32 m, u32 n, Real dx, Real dy);
+
+  /**
+   * @brief 3-D matrix-free Laplacian
+   *
+   * @param k Order of accuracy
+   * @param m Number of cells in x-direction
+   * @param n Number of cells in y-direction
+   * @param o Number of cells in z-direction
+   * @param dx Spacing between cells in x-direction
+   * @param dy Spacing between cells in y-direction
+   * @param dz Spacing between cells in z-direction
+   */
+  StencilLaplacian(u16 k, u32 m, u32 n, u32 o, Real dx, Real dy, Real dz);
+
+  /**
+   * @brief Takes explicit Euler steps u += dt*L*u, temporally blocked
+   *
+   * @param dt time step
+   * @param steps number of steps
+   * @param u field, updated in place
+   */
+  void diffuse(Real dt, u32 steps, vec &u);
+
+  /**
+   * @brief Sets the temporal blocking
+   *
+   * @param depth time steps per wavefront sweep, 1 sweeps the grid once
+   * per step
+   * @param tile planes per slab along the slowest axis, at least the reach
+   * of its stencil; slabs of a few thousand nodes if zero
+   */
+  void set_blocking(u32 depth, u32 tile = 0);
+
+  /**
+   * @brief Number of unknowns
+   */
+  uword size() const { return n_rows(); }
+
+private:
+  u32 depth = 4, tile = 0;
+  vec buffer;                 // Every other step of a sweep
+};
+
+#endif // STENCILLAPLACIAN_H
@@ -16,6 +16,9 @@
  */
 
 #include "utils.h"
+#include "divergence.h"
+#include "gradient.h"
+#include "solver.h"
 #include <cassert>
 
 #ifdef EIGEN
@@ -47,6 +50,10 @@ vec Utils::spsolve_eigen(const sp_mat &A, const vec &b) {
 
   return vec(eigen_x.data(), eigen_x.size());
 }
+
+void Utils::spsolve_eigen(const sp_mat &A, const mat &B, mat &X) {
+  LinearSolver::spsolve(A, B, X, "eigen-lu");
+}
 #endif
 
 // Basic implementation of Kronecker product
@@ -234,6 +241,37 @@ void Utils::meshgrid(const vec &x, const vec &y, const vec &z, cube &X, cube &Y,
     Z.slice(kk).fill(z(kk));
 }
 
+vec Utils::weightsP(u16 k, u32 m, Real dx) {
+  Gradient G(k, m, dx);
+
+  // G'P = b is consistent, so the last equation is redundant
+  sp_mat A = G.t();
+  A.shed_row(m + 1);
+
+  vec b(m + 1, fill::zeros);
+  b(0) = -1;
+
+  return LinearSolver::spsolve(A, b);
+}
+
+
+vec Utils::weightsQ(u16 k, u32 m, Real dx) {
+  Divergence D(k, m, dx);
+
+  // Only the interior rows of D take part, the boundary weights are one
+  sp_mat A = D.rows(1, m);
+  A = A.t();
+  A.shed_row(m);
+
+  vec b(m, fill::zeros);
+  b(0) = -1;
+
+  vec Q(m + 2, fill::ones);
+  Q.rows(1, m) = LinearSolver::spsolve(A, b);
+
+  return Q;
+}
+
 // Trapezoidal rule (trapz) for 1D integration
 double Utils::trapz(const vec &x, const vec &y) {
   assert(x.n_elem == y.n_elem);
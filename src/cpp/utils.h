@@ -68,6 +68,46 @@ public:
   */
   static vec spsolve_eigen(const sp_mat &A, const vec &b);
 
+  /**
+  * @brief Sparse solve of AX=B with Eigen for many right hand sides
+  *
+  * A is factorised once and blocks of columns of B are solved in parallel.
+  *
+  * @param A a sparse matrix LHS of AX=B
+  * @param B a matrix for the RHS of AX=B, one column per right hand side
+  * @param X the solutions, one column per right hand side
+  *
+  * @note This function requires the EIGEN to be used when Armadillo is built
+  */
+  static void spsolve_eigen(const sp_mat &A, const mat &B, mat &X);
+
+  /**
+  * @brief Returns the m+1 weights of the mimetic inner product P
+  *
+  * Solves G'P = [-1 0 ... 0 1]' for the Gradient of order k, as in the
+  * MATLAB/Octave weightsP function.
+  *
+  * @param k Order of accuracy
+  * @param m Number of cells
+  * @param dx Spacing between cells
+  *
+  * @note Unlike Gradient::getP(), these weights are exact and full length.
+  */
+  static vec weightsP(u16 k, u32 m, Real dx);
+
+  /**
+  * @brief Returns the m+2 weights of the mimetic inner product Q
+  *
+  * Solves D'Q = [-1 0 ... 0 1]' over the interior rows of the Divergence of
+  * order k, as in the MATLAB/Octave weightsQ function. The two boundary
+  * weights are one.
+  *
+  * @param k Order of accuracy
+  * @param m Number of cells
+  * @param dx Spacing between cells
+  */
+  static vec weightsQ(u16 k, u32 m, Real dx);
+
   /**
   * @brief An analog to the MATLAB/Octave 2D meshgrid operation
   *
@@ -0,0 +1,201 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file weightedlaplacian.cpp
+ *
+ * @brief Symmetric weighted formulation of the mimetic Laplacian + RobinBC
+ *
+ * @date 2026/10/19
+ */
+
+#include "weightedlaplacian.h"
+#include "robinbc.h"
+
+// 1-D Constructor
+WeightedLaplacian::WeightedLaplacian(u16 k, u32 m, Real dx, Real a, Real b) {
+  Gradient G(k, m, dx);
+  RobinBC BC(k, m, dx, a, b);
+
+  vec P = Utils::weightsP(k, m, dx);
+  vec Q = Utils::weightsQ(k, m, dx);
+
+  uvec type(m + 2, fill::zeros);
+  type(0) = type(m + 1) = 1;
+
+  assemble(G, P, Q, type, BC, a, b);
+}
+
+// 2-D Constructor
+WeightedLaplacian::WeightedLaplacian(u16 k, u32 m, Real dx, u32 n, Real dy,
+                                     Real a, Real b) {
+  Gradient G(k, m, n, dx, dy);
+  RobinBC BC(k, m, dx, n, dy, a, b);
+
+  vec Pm = Utils::weightsP(k, m, dx);
+  vec Pn = Utils::weightsP(k, n, dy);
+  vec Qm = Utils::weightsQ(k, m, dx);
+  vec Qn = Utils::weightsQ(k, n, dy);
+  vec Qm_in = Qm.rows(1, m);
+  vec Qn_in = Qn.rows(1, n);
+
+  // Faces are weighted by P along their normal and by Q across it
+  vec P = join_cols(kron(Qn_in, Pm), kron(Pn, Qm_in));
+  vec Q = kron(Qn, Qm);
+
+  // Number of boundary coordinates of each node
+  uvec type((m + 2) * (n + 2));
+  for (u32 j = 0; j < n + 2; ++j)
+    for (u32 i = 0; i < m + 2; ++i)
+      type(j * (m + 2) + i) = (i == 0 || i == m + 1) + (j == 0 || j == n + 1);
+
+  assemble(G, P, Q, type, BC, a, b);
+}
+
+// 3-D Constructor
+WeightedLaplacian::WeightedLaplacian(u16 k, u32 m, Real dx, u32 n, Real dy,
+                                     u32 o, Real dz, Real a, Real b) {
+  Gradient G(k, m, n, o, dx, dy, dz);
+  RobinBC BC(k, m, dx, n, dy, o, dz, a, b);
+
+  vec Pm = Utils::weightsP(k, m, dx);
+  vec Pn = Utils::weightsP(k, n, dy);
+  vec Po = Utils::weightsP(k, o, dz);
+  vec Qm = Utils::weightsQ(k, m, dx);
+  vec Qn = Utils::weightsQ(k, n, dy);
+  vec Qo = Utils::weightsQ(k, o, dz);
+  vec Qm_in = Qm.rows(1, m);
+  vec Qn_in = Qn.rows(1, n);
+  vec Qo_in = Qo.rows(1, o);
+
+  // Faces are weighted by P along their normal and by Q across it
+  vec P = join_cols(join_cols(kron(kron(Qo_in, Qn_in), Pm),
+                              kron(kron(Qo_in, Pn), Qm_in)),
+                    kron(kron(Po, Qn_in), Qm_in));
+  vec Q = kron(Qo, kron(Qn, Qm));
+
+  // Number of boundary coordinates of each node
+  uvec type((m + 2) * (n + 2) * (o + 2));
+  for (u32 l = 0; l < o + 2; ++l)
+    for (u32 j = 0; j < n + 2; ++j)
+      for (u32 i = 0; i < m + 2; ++i)
+        type((l * (n + 2) + j) * (m + 2) + i) = (i == 0 || i == m + 1) +
+                                                (j == 0 || j == n + 1) +
+                                                (l == 0 || l == o + 1);
+
+  assemble(G, P, Q, type, BC, a, b);
+}
+
+void WeightedLaplacian::assemble(const sp_mat &G, const vec &P, const vec &Q,
+                                 const uvec &type, const sp_mat &BC, Real a,
+                                 Real b) {
+  assert(a != 0 || b != 0);
+
+  uword N = Q.n_elem;
+
+  sp_mat Pd(P.n_elem, P.n_elem);
+  Pd.diag() = P;
+
+  // Symmetric by construction
+  sp_mat S = G.t() * Pd * G;
+
+  W.zeros(N);
+  vec E(N, fill::zeros);
+  vec interior(N, fill::zeros);
+  vec boundary(N, fill::zeros);
+
+  for (uword i = 0; i < N; ++i) {
+    if (type(i) == 0) {
+      W(i) = -Q(i);
+      interior(i) = 1;
+    } else if (type(i) == 1) {
+      if (b != 0) {
+        W(i) = Q(i) / b;
+        E(i) = a * Q(i) / b;
+      } else {
+        W(i) = 1 / a;
+        E(i) = 1;
+      }
+      boundary(i) = 1;
+    } else {
+      // Edges and corners are decoupled, recover() fills them in
+      E(i) = 1;
+    }
+  }
+
+  sp_mat Ed(N, N);
+  sp_mat In(N, N);
+  sp_mat Bd(N, N);
+  Ed.diag() = E;
+  In.diag() = interior;
+  Bd.diag() = boundary;
+
+  if (b != 0) {
+    *this = S + Ed;
+    lift.set_size(N, N);
+  } else {
+    // Move the known Dirichlet values to the RHS, keeping the symmetry
+    *this = In * S * In + Ed;
+    lift = In * S * Bd;
+  }
+
+  // Passive nodes, edges (2 boundary coordinates) before corners (3)
+  passive = join_cols(find(type == 2), find(type == 3));
+
+  umat locations(2, passive.n_elem);
+  for (uword r = 0; r < passive.n_elem; ++r) {
+    locations(0, r) = r;
+    locations(1, r) = passive(r);
+  }
+  sp_mat select(locations, vec(passive.n_elem, fill::ones), passive.n_elem,
+                N);
+
+  closure = select * BC;
+  closure = closure.t();
+}
+
+vec WeightedLaplacian::rhs(const vec &f) const {
+  vec r = W % f;
+
+  if (lift.n_nonzero)
+    r -= lift * r;
+
+  return r;
+}
+
+vec WeightedLaplacian::recover(const vec &y, const vec &f) const {
+  vec u = y;
+
+  for (uword r = 0; r < passive.n_elem; ++r) {
+    uword p = passive(r);
+    Real diag = 0;
+    Real acc = f(p);
+
+    for (auto it = closure.begin_col(r); it != closure.end_col(r); ++it) {
+      if (it.row() == p)
+        diag = *it;
+      else
+        acc -= (*it) * u(it.row());
+    }
+
+    u(p) = acc / diag;
+  }
+
+  return u;
+}
+
+vec WeightedLaplacian::solve(const vec &f, Real tol, u32 maxit,
+                             KrylovInfo *info) const {
+  const sp_mat &S = *this;
+  vec y;
+
+  KrylovInfo report = Krylov::cg(Krylov::op(S), rhs(f), y, Krylov::jacobi(S),
+                                 tol, maxit);
+  if (info)
+    *info = report;
+
+  return recover(y, f);
+}
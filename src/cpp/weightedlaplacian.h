@@ -0,0 +1,127 @@
+/*
+* SPDX-License-Identifier: GPL-3.0-or-later
+* © 2008-2024 San Diego State University Research Foundation (SDSURF).
+* See LICENSE file or https://www.gnu.org/licenses/gpl-3.0.html for details.
+*/
+
+/*
+ * @file weightedlaplacian.h
+ *
+ * @brief Symmetric weighted formulation of the mimetic Laplacian + RobinBC
+ *
+ * @date 2026/10/19
+ */
+
+#ifndef WEIGHTEDLAPLACIAN_H
+#define WEIGHTEDLAPLACIAN_H
+
+#include "gradient.h"
+#include "krylov.h"
+
+/**
+ * @brief Symmetric positive (semi)definite form of Laplacian + RobinBC
+ *
+ * Builds S = G'PG + (a/b)E from the mimetic Gradient G and the exact P and Q
+ * inner product weights, where E holds the Q weights of the boundary nodes.
+ * Rows of the system (L + BC)u = f are weighted by -Q (cells) and Q/b
+ * (boundary), so S can be solved with Conjugate Gradient.
+ *
+ * With b = 0 (Dirichlet) the known boundary values are eliminated
+ * symmetrically instead.
+ *
+ * S is positive definite for a/b > 0 and semidefinite for pure Neumann.
+ *
+ * @note S is the weighted L + BC with the boundary operator B = QD + G'P
+ * dropped, which is what makes it symmetric. B acts next to every boundary
+ * for every k, so solve() does not return the solution of (L + BC)u = f:
+ * the residual of its solution in L + BC vanishes except within 3, 9 and 12
+ * rows of either end for k = 2, 4 and 6 in 1-D, and it is second-order
+ * accurate for every k. Use LinearSolver on L + BC where the k-th order
+ * boundary closure matters.
+ */
+class WeightedLaplacian : public sp_mat {
+
+public:
+  using sp_mat::operator=;
+
+  /**
+   * @brief 1-D Weighted Laplacian Constructor
+   *
+   * @param k Order of accuracy
+   * @param m Number of cells
+   * @param dx Spacing between cells
+   * @param a Coefficient of the Dirichlet function
+   * @param b Coefficient of the Neumann function
+   */
+  WeightedLaplacian(u16 k, u32 m, Real dx, Real a, Real b);
+
+  /**
+   * @brief 2-D Weighted Laplacian Constructor
+   *
+   * @param k Order of accuracy
+   * @param m Number of cells in x-direction
+   * @param dx Spacing between cells in x-direction
+   * @param n Number of cells in y-direction
+   * @param dy Spacing between cells in y-direction
+   * @param a Coefficient of the Dirichlet function
+   * @param b Coefficient of the Neumann function
+   */
+  WeightedLaplacian(u16 k, u32 m, Real dx, u32 n, Real dy, Real a, Real b);
+
+  /**
+   * @brief 3-D Weighted Laplacian Constructor
+   *
+   * @param k Order of accuracy
+   * @param m Number of cells in x-direction
+   * @param dx Spacing between cells in x-direction
+   * @param n Number of cells in y-direction
+   * @param dy Spacing between cells in y-direction
+   * @param o Number of cells in z-direction
+   * @param dz Spacing between cells in z-direction
+   * @param a Coefficient of the Dirichlet function
+   * @param b Coefficient of the Neumann function
+   */
+  WeightedLaplacian(u16 k, u32 m, Real dx, u32 n, Real dy, u32 o, Real dz,
+                    Real a, Real b);
+
+  /**
+   * @brief Maps the RHS of (L + BC)u = f to the RHS of the symmetric system
+   *
+   * @param f source at the cells and boundary data at the boundary nodes
+   */
+  vec rhs(const vec &f) const;
+
+  /**
+   * @brief Recovers the solution of (L + BC)u = f from the symmetric one
+   *
+   * Fills in the edge and corner nodes, which the Gradient never touches and
+   * only the boundary condition determines.
+   *
+   * @param y solution of the symmetric system
+   * @param f same RHS that was passed to rhs()
+   */
+  vec recover(const vec &y, const vec &f) const;
+
+  /**
+   * @brief Solves the weighted system S with Conjugate Gradient
+   *
+   * @param f source at the cells and boundary data at the boundary nodes,
+   * as for L + BC
+   * @param tol relative residual tolerance
+   * @param maxit maximum number of iterations, the system size if zero
+   * @param info optional convergence report
+   */
+  vec solve(const vec &f, Real tol = 1e-10, u32 maxit = 0,
+            KrylovInfo *info = nullptr) const;
+
+private:
+  void assemble(const sp_mat &G, const vec &P, const vec &Q,
+                const uvec &type, const sp_mat &BC, Real a, Real b);
+
+  vec W;         // Row weights applied to f
+  sp_mat lift;   // Coupling to the eliminated Dirichlet values
+  uvec passive;  // Edge and corner nodes, filled in by recover()
+  sp_mat closure; // Transposed BC rows of the passive nodes
+};
+
+#endif // WEIGHTEDLAPLACIAN_H
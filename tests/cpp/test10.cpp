@@ -0,0 +1,317 @@
+#include "mole.h"
+#include <gtest/gtest.h>
+
+// Observed order of method on u' = f(t, u) from t = 0 to 1
+Real observed_order(Integrator::Method method, const Integrator::RHS &f,
+                    const vec &u0, const vec &exact) {
+    Real errors[2];
+
+    for (int r = 0; r < 2; ++r) {
+        Integrator integrator(method, f);
+        vec u = u0;
+        integrator.integrate(0, 1, 0.1 / (1 << r), u);
+        errors[r] = norm(u - exact);
+    }
+
+    return std::log2(errors[0] / errors[1]);
+}
+
+TEST(IntegratorTests, ExplicitOrders) {
+    // Harmonic oscillator u1' = u2, u2' = -u1
+    sp_mat A(2, 2);
+    A(0, 1) = 1;
+    A(1, 0) = -1;
+    Integrator::RHS oscillator = Integrator::linear(A);
+
+    // Nonautonomous u' = cos(t), checks the stage times
+    Integrator::RHS forcing = [](Real t, const vec &, vec &du) {
+        du.fill(std::cos(t));
+    };
+
+    vec u0 = {1, 0};
+    vec exact = {std::cos(1.0), -std::sin(1.0)};
+
+    for (auto method : {Integrator::EULER, Integrator::SSPRK2,
+                        Integrator::SSPRK3, Integrator::RK4}) {
+        Integrator integrator(method, oscillator);
+        Real p = integrator.order();
+
+        ASSERT_GT(observed_order(method, oscillator, u0, exact), p - 0.2);
+        ASSERT_GT(observed_order(method, forcing, vec{0}, vec{std::sin(1.0)}),
+                  p - 0.2);
+    }
+}
+
+TEST(IntegratorTests, LinearRHS) {
+    int k = 4, m = 20;
+    Laplacian L(k, m, 1.0 / m);
+    vec u = linspace(0, 1, m + 2);
+    vec du(m + 2);
+
+    Integrator::linear(L)(0, u, du);
+    ASSERT_LT(norm(du - L * u), 1e-10 * norm(L * u));
+}
+
+TEST(IntegratorTests, Verlet) {
+    sp_mat A(1, 1);
+    A(0, 0) = -1;
+
+    for (auto method : {Verlet::VELOCITY, Verlet::POSITION}) {
+        Real errors[2];
+
+        for (int r = 0; r < 2; ++r) {
+            Verlet verlet(method, Integrator::linear(A));
+            vec u = {1}, v = {0};
+            verlet.integrate(0, 1, 0.1 / (1 << r), u, v);
+            errors[r] = std::hypot(u(0) - std::cos(1.0), v(0) + std::sin(1.0));
+        }
+        ASSERT_GT(std::log2(errors[0] / errors[1]), 1.8);
+
+        // Symplectic, so the energy does not drift over many periods
+        Verlet verlet(method, Integrator::linear(A));
+        vec u = {1}, v = {0};
+        u32 steps = verlet.integrate(0, 1000 * 2 * M_PI, 0.1, u, v);
+        ASSERT_GT(steps, 60000);
+        ASSERT_NEAR(u(0) * u(0) + v(0) * v(0), 1.0, 1e-2);
+    }
+}
+
+TEST(IntegratorTests, ImplicitOrders) {
+    // Heat equation with Dirichlet boundaries, the zero boundary rows of the
+    // Laplacian keep them fixed
+    int k = 2, m = 40;
+    Laplacian L(k, m, 1.0 / m);
+    vec x = linspace(0, 1, m + 2);
+    vec u0 = sin(M_PI * x);
+    u0(0) = u0(m + 1) = 0;
+
+    Real T = 0.1;
+    vec exact = expmat(T * mat(L)) * u0;
+
+    struct Case {
+        ImplicitIntegrator::Method method;
+        Real theta;
+        Real order;
+    };
+
+    for (Case c : {Case{ImplicitIntegrator::THETA, 1.0, 1},
+                   Case{ImplicitIntegrator::THETA, 0.5, 2},
+                   Case{ImplicitIntegrator::BDF2, 0, 2}}) {
+        Real errors[2];
+
+        for (int r = 0; r < 2; ++r) {
+            u32 steps = 10 << r;
+            ImplicitIntegrator integrator(L, T / steps, c.method, c.theta);
+            vec u = u0;
+            ASSERT_NEAR(integrator.integrate(0, steps, u), T, 1e-14);
+            errors[r] = norm(u - exact);
+        }
+
+        ASSERT_GT(std::log2(errors[0] / errors[1]), c.order - 0.2);
+    }
+}
+
+TEST(IntegratorTests, ImplicitSource) {
+    // u' = cos(t) through the source term alone
+    sp_mat L(1, 1);
+
+    for (auto method : {ImplicitIntegrator::THETA, ImplicitIntegrator::BDF2}) {
+        ImplicitIntegrator integrator(L, 0.01, method);
+        integrator.set_source([](Real t, vec &g) { g.fill(std::cos(t)); });
+
+        vec u = {0};
+        integrator.integrate(0, 100, u);
+        ASSERT_NEAR(u(0), std::sin(1.0), 1e-4);
+    }
+
+    // A source set after the first step
+    ImplicitIntegrator integrator(L, 0.01);
+    vec u = {0};
+    integrator.step(0, u);
+    integrator.set_source([](Real t, vec &g) { g.fill(1); });
+    integrator.step(0.01, u);
+    ASSERT_NEAR(u(0), 0.01, 1e-12);
+}
+
+TEST(IntegratorTests, ImplicitLargeSteps) {
+    // A step far beyond the explicit limit dx^2/3 stays bounded
+    int m = 100;
+    Laplacian L(2, m, 1.0 / m);
+    vec u(m + 2, fill::ones);
+    u(0) = u(m + 1) = 0;
+
+    ImplicitIntegrator integrator(L, 0.05, ImplicitIntegrator::BDF2);
+    integrator.integrate(0, 40, u);
+
+    ASSERT_LT(abs(u).max(), 1e-3);
+}
+
+TEST(IntegratorTests, AdaptiveTolerance) {
+    sp_mat A(2, 2);
+    A(0, 1) = 1;
+    A(1, 0) = -1;
+    vec exact = {std::cos(10.0), -std::sin(10.0)};
+
+    for (auto method : {AdaptiveIntegrator::BOGACKI_SHAMPINE,
+                        AdaptiveIntegrator::DORMAND_PRINCE}) {
+        Real previous = 1;
+        u32 steps = 0;
+
+        for (Real tol : {1e-4, 1e-7, 1e-10}) {
+            AdaptiveIntegrator integrator(method, Integrator::linear(A), tol,
+                                          tol);
+            vec u = {1, 0};
+            AdaptiveStats stats = integrator.integrate(0, 10, u);
+
+            Real error = norm(u - exact);
+            ASSERT_LT(error, 1000 * tol);
+            ASSERT_LT(error, previous);
+            ASSERT_GT(stats.accepted, steps);
+
+            previous = error;
+            steps = stats.accepted;
+        }
+    }
+}
+
+TEST(IntegratorTests, AdaptiveStability) {
+    // Diffusion at a loose tolerance is limited by stability, the steps
+    // should settle near the explicit limit instead of collapsing
+    int m = 50;
+    Real dx = 1.0 / m;
+    Laplacian L(2, m, dx);
+    vec u = sin(M_PI * linspace(0, 1, m + 2));
+
+    AdaptiveIntegrator integrator(AdaptiveIntegrator::BOGACKI_SHAMPINE,
+                                  Integrator::linear(L), 1e-3, 1e-6);
+    AdaptiveStats stats = integrator.integrate(0, 0.5, u);
+
+    ASSERT_GT(stats.dt_max, 0.2 * dx * dx);
+    ASSERT_LT(stats.rejected, stats.accepted);
+    ASSERT_LT(abs(u).max(), 1e-1);
+}
+
+TEST(IntegratorTests, ExpmvDiffusion) {
+    int m = 40;
+    Laplacian L(2, m, 1.0 / m);
+    vec u0 = linspace(0, 1, m + 2);
+    u0 = u0 % (1 - u0) + 0.1;
+
+    Real T = 0.1;
+    vec exact = expmat(T * mat(L)) * u0;
+
+    Expmv expmv(L, 1e-10);
+    vec u;
+    ExpmvInfo info = expmv.apply(T, u0, u);
+
+    ASSERT_LT(norm(u - exact), 1e-8 * norm(exact));
+    ASSERT_LT(info.error, 1e-8);
+
+    // Forward Euler would need T / (dx^2 / 3) = 480 steps
+    ASSERT_LT(info.substeps, 48);
+}
+
+TEST(IntegratorTests, ExpmvSchrodinger) {
+    int m = 50;
+    Laplacian L(2, m, 1.0 / m);
+    RobinBC BC(2, m, 1.0 / m, 1, 0);
+    sp_mat H = -0.5 * (L + BC);
+
+    vec x = linspace(0, 1, m + 2);
+    cx_vec psi0 = cx_vec(sin(M_PI * x) % exp(-10 * square(x - 0.5)),
+                         zeros<vec>(m + 2));
+
+    // psi(t) = exp(-itH) psi0
+    Real T = 0.05;
+    cx_vec exact = expmat(cx_mat(zeros<mat>(m + 2, m + 2), -T * mat(H))) * psi0;
+
+    Expmv expmv(-H, 1e-10);
+    cx_vec psi, back;
+    expmv.apply(T, psi0, psi);
+    ASSERT_LT(norm(psi - exact), 1e-8 * norm(exact));
+
+    // Backwards in time recovers the initial state
+    expmv.apply(-T, psi, back);
+    ASSERT_LT(norm(back - psi0), 1e-8 * norm(psi0));
+}
+
+TEST(IntegratorTests, ImexOrders) {
+    // Advection-diffusion, diffusion implicit and advection explicit
+    int m = 40;
+    Real dx = 1.0 / m, nu = 0.1, c = 1;
+    Laplacian Lap(2, m, dx);
+    Divergence D(2, m, dx);
+    Interpol I(m, 0.5);
+
+    sp_mat L = nu * Lap;
+    sp_mat A = -c * D * I;
+
+    vec x = linspace(0, 1, m + 2);
+    vec u0 = sin(M_PI * x);
+
+    Real T = 0.2;
+    vec exact = expmat(T * mat(L + A)) * u0;
+
+    struct Case {
+        ImexIntegrator::Method method;
+        Real order;
+    };
+
+    for (Case c : {Case{ImexIntegrator::IMEX_EULER, 1},
+                   Case{ImexIntegrator::ARS222, 2},
+                   Case{ImexIntegrator::STRANG, 2}}) {
+        Real errors[2];
+
+        for (int r = 0; r < 2; ++r) {
+            u32 steps = 10 << r;
+            ImexIntegrator integrator(L, Integrator::linear(A), T / steps,
+                                      c.method);
+            vec u = u0;
+            integrator.integrate(0, steps, u);
+            errors[r] = norm(u - exact);
+        }
+
+        ASSERT_GT(std::log2(errors[0] / errors[1]), c.order - 0.25);
+    }
+}
+
+TEST(IntegratorTests, Parareal) {
+    int m = 30;
+    Laplacian L(2, m, 1.0 / m);
+    Integrator::RHS f = Integrator::linear(L);
+    vec u0 = sin(M_PI * linspace(0, 1, m + 2));
+
+    u32 slices = 8;
+    Real T = 0.2;
+    Parareal::Propagator fine =
+        Parareal::propagator(Integrator::RK4, f, 1e-4);
+    Parareal::Propagator coarse =
+        Parareal::propagator(Integrator::SSPRK3, f, 3e-4);
+
+    // Serial fine solution over the same slices
+    vec reference = u0;
+    for (u32 n = 0; n < slices; ++n)
+        fine(T * n / slices, T * (n + 1) / slices, reference);
+
+    Parareal parareal(coarse, fine, slices);
+    vec u = u0;
+    PararealInfo info = parareal.solve(0, T, u, 1e-10);
+
+    ASSERT_TRUE(info.converged);
+    ASSERT_LT(info.history.size(), slices);
+    ASSERT_LT(norm(u - reference), 1e-8 * norm(reference));
+    ASSERT_EQ(parareal.states().size(), slices + 1);
+
+    // Exact after one iteration per slice, whatever the coarse propagator
+    Parareal::Propagator euler = Parareal::propagator(Integrator::EULER, f,
+                                                      2e-4);
+    Parareal exact(euler, fine, 4);
+    u = u0;
+    info = exact.solve(0, T / 2, u, 0);
+    reference = u0;
+    for (u32 n = 0; n < 4; ++n)
+        fine(T / 2 * n / 4, T / 2 * (n + 1) / 4, reference);
+
+    ASSERT_EQ(info.history.size(), 4);
+    ASSERT_LT(norm(u - reference), 1e-12 * norm(reference));
+}
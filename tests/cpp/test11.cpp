@@ -0,0 +1,71 @@
+#include "mole.h"
+#include <gtest/gtest.h>
+
+void check_stencil(const sp_mat &L, StencilLaplacian &S) {
+    ASSERT_EQ(S.size(), L.n_rows);
+
+    vec u = randu<vec>(L.n_rows);
+    vec Lu;
+    S.apply(u, Lu);
+    ASSERT_LT(norm(Lu - L * u), 1e-10 * norm(L * u));
+
+    // Temporally blocked steps match plain explicit Euler
+    Real dt = 0.1 / abs(L).max();
+    u32 steps = 9;
+    vec reference = u;
+    for (u32 s = 0; s < steps; ++s)
+        reference += dt * (L * reference);
+
+    // Default blocking, several steps per sweep
+    vec v = u;
+    S.diffuse(dt, steps, v);
+    ASSERT_LT(norm(v - reference), 1e-10 * norm(reference)) << "default";
+
+    for (u32 depth : {1, 2, 4}) {
+        for (u32 tile : {0, 3}) {
+            S.set_blocking(depth, tile);
+            vec v = u;
+            S.diffuse(dt, steps, v);
+            ASSERT_LT(norm(v - reference), 1e-10 * norm(reference))
+                << "depth " << depth << ", tile " << tile;
+        }
+    }
+}
+
+TEST(StencilLaplacianTests, OneDimensional) {
+    for (u16 k : {2, 4}) {
+        int m = 3 * k + 20;
+        Real dx = 1.0 / m;
+        Laplacian L(k, m, dx);
+        StencilLaplacian S(k, m, dx);
+        check_stencil(L, S);
+    }
+}
+
+TEST(StencilLaplacianTests, TwoDimensional) {
+    for (u16 k : {2, 4}) {
+        int m = 2 * k + 9, n = 2 * k + 12;
+        Laplacian L(k, m, n, 1.0 / m, 2.0 / n);
+        StencilLaplacian S(k, m, n, 1.0 / m, 2.0 / n);
+        check_stencil(L, S);
+    }
+}
+
+TEST(StencilLaplacianTests, ThreeDimensional) {
+    for (u16 k : {2, 4}) {
+        int m = 2 * k + 3, n = 2 * k + 5, o = 2 * k + 7;
+        Laplacian L(k, m, n, o, 1.0 / m, 1.0 / n, 1.0 / o);
+        StencilLaplacian S(k, m, n, o, 1.0 / m, 1.0 / n, 1.0 / o);
+        check_stencil(L, S);
+    }
+}
+
+TEST(StencilLaplacianTests, ThreeDimensionalSlabs) {
+    // Many slabs per wavefront sweep, with the default slab size
+    for (u16 k : {2, 4}) {
+        int m = 60;
+        Laplacian L(k, m, m, m, 1.0 / m, 1.0 / m, 1.0 / m);
+        StencilLaplacian S(k, m, m, m, 1.0 / m, 1.0 / m, 1.0 / m);
+        check_stencil(L, S);
+    }
+}
@@ -0,0 +1,90 @@
+#include "mole.h"
+#include <gtest/gtest.h>
+
+TEST(GridTests, SizesMatchOperators) {
+    u16 k = 2;
+    u32 m = 7, n = 6, o = 5;
+
+    Grid1D g1(m, 0, 1);
+    Gradient G1(k, m, g1.dx);
+    EXPECT_EQ(g1.n_centers(), G1.n_cols);
+    EXPECT_EQ(g1.n_faces(), G1.n_rows);
+
+    Grid2D g2(m, n, 0, 1, 0, 2);
+    Gradient G2(k, m, n, g2.dx, g2.dy);
+    EXPECT_EQ(g2.n_centers(), G2.n_cols);
+    EXPECT_EQ(g2.n_faces(), G2.n_rows);
+
+    Grid3D g3(m, n, o, 0, 1, 0, 2, 0, 3);
+    Gradient G3(k, m, n, o, g3.dx, g3.dy, g3.dz);
+    EXPECT_EQ(g3.n_centers(), G3.n_cols);
+    EXPECT_EQ(g3.n_faces(), G3.n_rows);
+}
+
+TEST(GridTests, ViewsAliasStorage) {
+    Grid3D grid(4, 3, 2, 0, 1, 0, 1, 0, 1);
+    vec u(grid.n_centers(), fill::zeros);
+
+    Field f = grid.centers(u);
+    f(2, 1, 3) = 5;
+    EXPECT_EQ(u(grid.index(2, 1, 3)), 5);
+
+    cube c = f.as_cube();
+    EXPECT_EQ(c.memptr(), u.memptr());
+    EXPECT_EQ(c(2, 1, 3), 5);
+
+    mat s = f.as_mat();
+    s(0, 0) = 2;
+    EXPECT_EQ(u(0), 2);
+    EXPECT_EQ(f.as_vec().memptr(), u.memptr());
+}
+
+TEST(GridTests, FaceComponents) {
+    // The gradient of z is one on the z-faces and zero elsewhere
+    u16 k = 2;
+    Grid3D grid(5, 4, 6, 0, 1, 0, 1, 0, 2);
+    Gradient G(k, grid.m, grid.n, grid.o, grid.dx, grid.dy, grid.dz);
+
+    vec z = grid.zc(), u(grid.n_centers());
+    Field f = grid.centers(u);
+    for (uword l = 0; l < f.n_slices; ++l)
+        for (uword j = 0; j < f.n_cols; ++j)
+            for (uword i = 0; i < f.n_rows; ++i)
+                f(i, j, l) = z(l);
+
+    vec v = G * u;
+    Field vx = grid.faces(v, 0), vy = grid.faces(v, 1), vz = grid.faces(v, 2);
+
+    EXPECT_EQ(vx.size() + vy.size() + vz.size(), v.n_elem);
+    EXPECT_LT(norm(vx.as_vec()), 1e-10);
+    EXPECT_LT(norm(vy.as_vec()), 1e-10);
+    EXPECT_LT(norm(vz.as_vec() - 1), 1e-10);
+    EXPECT_EQ(vz.n_slices, grid.o + 1);
+
+    vec xf = grid.xf();
+    EXPECT_EQ(xf.n_elem, grid.m + 1);
+    EXPECT_DOUBLE_EQ(xf(grid.m), 1);
+}
+
+TEST(GridTests, FaceFieldMatchesOperatorOrder) {
+    // The divergence of (x, 0) is one at every center
+    u16 k = 2;
+    Grid2D grid(6, 5, 0, 3, 0, 1);
+    Divergence D(k, grid.m, grid.n, grid.dx, grid.dy);
+
+    FaceField<Grid2D> w(grid);
+    Field wx = w.component(0);
+    vec xf = grid.xf();
+    for (uword j = 0; j < wx.n_cols; ++j)
+        for (uword i = 0; i < wx.n_rows; ++i)
+            wx(i, j) = xf(i);
+
+    EXPECT_EQ(wx.memptr(), w.values.memptr());
+    EXPECT_EQ(w.component(1).memptr(), w.values.memptr() + wx.size());
+
+    vec d = D * w.values;
+    Field f = grid.centers(d);
+    for (u32 j = 1; j <= grid.n; ++j)
+        for (u32 i = 1; i <= grid.m; ++i)
+            EXPECT_NEAR(f(i, j), 1, 1e-10);
+}
@@ -0,0 +1,105 @@
+#include "mole.h"
+#include <gtest/gtest.h>
+
+// Stretched coordinate, cells cluster near both ends
+Real stretch(Real s) { return s - 0.25 * std::sin(2 * M_PI * s) / (2 * M_PI); }
+
+// Centers' ticks with the boundaries, and edges' ticks, of m stretched cells
+vec centers(u32 m) {
+    vec x(m + 2);
+    x(0) = 0;
+    x(m + 1) = 1;
+    for (u32 i = 0; i < m; ++i)
+        x(i + 1) = stretch((i + 0.5) / m);
+    return x;
+}
+
+vec edges(u32 m) {
+    vec x(m + 1);
+    for (u32 i = 0; i <= m; ++i)
+        x(i) = stretch(Real(i) / m);
+    return x;
+}
+
+TEST(NonUniformTests, UniformTicks) {
+    u16 k = 4;
+    u32 m = 12, n = 10;
+    Real dx = 1.0 / m, dy = 2.0 / n;
+
+    Grid2D grid(m, n, 0, 1, 0, 2);
+    vec xc = grid.xc(), yc = grid.yc();
+
+    Gradient G(k, m, n, dx, dy);
+    Gradient Gnu(k, xc, yc);
+    EXPECT_LT(abs(G - Gnu).max(), 1e-10);
+
+    Divergence D(k, m, n, dx, dy);
+    Divergence Dnu(k, grid.xf(), grid.yf());
+    EXPECT_LT(abs(D - Dnu).max(), 1e-10);
+
+    EXPECT_LT(abs(Gnu.getJ(1) - 1 / dy).max(), 1e-10);
+
+    // The 1-D operators keep the weights of the uniform ones
+    Gradient G1(k, m, dx);
+    Gradient G1nu(k, xc);
+    ASSERT_FALSE(G1nu.getP().is_empty());
+    EXPECT_LT(abs(G1nu.getP() - G1.getP()).max(), 1e-15);
+
+    Divergence D1(k, m, dx);
+    Divergence D1nu(k, grid.xf());
+    ASSERT_FALSE(D1nu.getQ().is_empty());
+    EXPECT_LT(abs(D1nu.getQ() - D1.getQ()).max(), 1e-15);
+}
+
+TEST(NonUniformTests, GradientConvergence) {
+    u16 k = 2;
+    Real previous = 0;
+
+    for (u32 m : {20, 40, 80}) {
+        vec xc = centers(m), xf = edges(m);
+        Gradient G(k, xc);
+
+        vec error = G * vec(sin(2 * xc)) - 2 * cos(2 * xf);
+        Real e = abs(error).max();
+        if (previous > 0) {
+            EXPECT_GT(previous / e, 3.5);
+        }
+        previous = e;
+    }
+}
+
+TEST(NonUniformTests, LinearFields3D) {
+    u16 k = 2;
+    u32 m = 6, n = 5, o = 7;
+    vec xc = centers(m), yc = centers(n), zc = centers(o);
+
+    // The gradient of z is (0, 0, 1)
+    Gradient G(k, xc, yc, zc);
+    vec u(G.n_cols);
+    for (u32 l = 0; l < o + 2; ++l)
+        u.subvec(l * (m + 2) * (n + 2), (l + 1) * (m + 2) * (n + 2) - 1).fill(zc(l));
+
+    vec v = G * u;
+    uword z0 = (m + 1) * n * o + m * (n + 1) * o;
+    EXPECT_LT(abs(v.head(z0)).max(), 1e-10);
+    EXPECT_LT(abs(v.tail(v.n_elem - z0) - 1).max(), 1e-10);
+
+    // The divergence of (x, 0, 0) is one at the centers
+    Divergence D(k, edges(m), edges(n), edges(o));
+    vec F(D.n_cols, fill::zeros);
+    vec xf = edges(m);
+    for (uword f = 0; f < (m + 1) * n * o; ++f)
+        F(f) = xf(f % (m + 1));
+
+    vec div = D * F;
+    for (u32 l = 1; l <= o; ++l)
+        for (u32 j = 1; j <= n; ++j)
+            for (u32 i = 1; i <= m; ++i)
+                EXPECT_NEAR(div(i + (m + 2) * (j + (n + 2) * l)), 1, 1e-10);
+}
+
+TEST(NonUniformTests, InvalidTicks) {
+    vec ticks = centers(10);
+    std::swap(ticks(3), ticks(4));
+    EXPECT_THROW(Gradient(2, ticks), std::invalid_argument);
+}
@@ -0,0 +1,111 @@
+#include "mole.h"
+#include <gtest/gtest.h>
+
+// Node coordinates of m x n cells in meshgrid layout, a sheared square if
+// bend is zero
+void grid2D(u32 m, u32 n, Real bend, mat &X, mat &Y) {
+    X.set_size(n + 1, m + 1);
+    Y.set_size(n + 1, m + 1);
+    for (u32 j = 0; j <= n; ++j) {
+        for (u32 i = 0; i <= m; ++i) {
+            Real s = Real(i) / m, t = Real(j) / n;
+            X(j, i) = s + 0.2 * t + bend * std::sin(M_PI * s) * std::sin(2 * M_PI * t);
+            Y(j, i) = t + 0.1 * s + bend * std::sin(2 * M_PI * s) * std::sin(M_PI * t);
+        }
+    }
+}
+
+// Maximum error of the curvilinear gradient of u = sin(2x)cos(y)
+Real gradient_error(u32 m) {
+    mat X, Y;
+    grid2D(m, m, 0.1, X, Y);
+    Jacobian jacobian(2, X, Y);
+    Gradient G(2, jacobian);
+
+    sp_mat Tc = jacobian.nodes_to(2), Tx = jacobian.nodes_to(0), Ty = jacobian.nodes_to(1);
+    vec xn = vectorise(X.t()), yn = vectorise(Y.t());
+    vec xc = Tc * xn, yc = Tc * yn;
+
+    vec g = G * vec(sin(2 * xc) % cos(yc));
+    uword nx = Tx.n_rows;
+    vec x = Tx * xn, y = Tx * yn;
+    Real e = abs(g.head(nx) - 2 * cos(2 * x) % cos(y)).max();
+    x = Ty * xn;
+    y = Ty * yn;
+    return std::max(e, abs(g.tail(g.n_elem - nx) + sin(2 * x) % sin(y)).max());
+}
+
+TEST(CurvilinearTests, AffineExact2D) {
+    u32 m = 9, n = 7;
+    mat X, Y;
+    grid2D(m, n, 0, X, Y);
+    Jacobian jacobian(2, X, Y);
+
+    vec xn = vectorise(X.t()), yn = vectorise(Y.t());
+    sp_mat Tc = jacobian.nodes_to(2), Tx = jacobian.nodes_to(0), Ty = jacobian.nodes_to(1);
+
+    // The gradient of 2x + 3y is (2, 3)
+    Gradient G(2, jacobian);
+    ASSERT_EQ(G.n_rows, 2 * m * n + m + n);
+    vec g = G * vec(2 * (Tc * xn) + 3 * (Tc * yn));
+    EXPECT_LT(abs(g.head(Tx.n_rows) - 2).max(), 1e-10);
+    EXPECT_LT(abs(g.tail(Ty.n_rows) - 3).max(), 1e-10);
+
+    // The divergence of (x, y) is two inside
+    Divergence D(2, jacobian);
+    vec div = D * vec(join_cols(vec(Tx * xn), vec(Ty * yn)));
+    for (u32 j = 1; j <= n; ++j)
+        for (u32 i = 1; i <= m; ++i)
+            EXPECT_NEAR(div(i + (m + 2) * j), 2, 1e-10);
+}
+
+TEST(CurvilinearTests, Convergence2D) {
+    Real coarse = gradient_error(16), fine = gradient_error(32);
+    EXPECT_GT(coarse / fine, 3.0);
+}
+
+TEST(CurvilinearTests, AffineExact3D) {
+    u32 m = 5, n = 6, o = 4;
+    cube X(n + 1, m + 1, o + 1), Y(n + 1, m + 1, o + 1), Z(n + 1, m + 1, o + 1);
+    for (u32 l = 0; l <= o; ++l) {
+        for (u32 j = 0; j <= n; ++j) {
+            for (u32 i = 0; i <= m; ++i) {
+                X(j, i, l) = i + 0.3 * j;
+                Y(j, i, l) = j + 0.2 * l;
+                Z(j, i, l) = l + 0.1 * i;
+            }
+        }
+    }
+    Jacobian jacobian(2, X, Y, Z);
+
+    vec xn(X.n_elem), yn(X.n_elem), zn(X.n_elem);
+    for (u32 l = 0; l <= o; ++l)
+        for (u32 j = 0; j <= n; ++j)
+            for (u32 i = 0; i <= m; ++i) {
+                uword id = i + (m + 1) * (j + (n + 1) * l);
+                xn(id) = X(j, i, l);
+                yn(id) = Y(j, i, l);
+                zn(id) = Z(j, i, l);
+            }
+
+    // The gradient of x - 2y + 3z is (1, -2, 3)
+    Gradient G(2, jacobian);
+    sp_mat Tc = jacobian.nodes_to(3);
+    vec g = G * vec(Tc * (xn - 2 * yn + 3 * zn));
+
+    uword row = 0;
+    Real expected[3] = {1, -2, 3};
+    for (u16 d = 0; d < 3; ++d) {
+        uword faces = jacobian.nodes_to(d).n_rows;
+        EXPECT_LT(abs(g.subvec(row, row + faces - 1) - expected[d]).max(), 1e-10);
+        row += faces;
+    }
+    EXPECT_EQ(row, g.n_elem);
+}
+
+TEST(CurvilinearTests, FoldedGrid) {
+    mat X, Y;
+    grid2D(8, 8, 0, X, Y);
+    X.col(4) = X.col(6) + 0.1;
+    EXPECT_THROW(Jacobian(2, X, Y), std::invalid_argument);
+}
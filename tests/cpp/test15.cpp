@@ -0,0 +1,125 @@
+#include "mole.h"
+#include <gtest/gtest.h>
+
+void check_operator(const sp_mat &A, const MatrixFreeOperator &P) {
+    ASSERT_EQ(P.n_rows(), A.n_rows);
+    ASSERT_EQ(P.n_cols(), A.n_cols);
+
+    vec x = randu<vec>(A.n_cols), y;
+    P.apply(x, y);
+    ASSERT_LT(norm(y - A * x), 1e-10 * norm(A * x));
+}
+
+TEST(PeriodicTests, NonPeriodicAxesMatchAssembled) {
+    u32 m = 11, n = 9, o = 8;
+    Real dx = 0.1, dy = 0.2, dz = 0.3;
+
+    for (u16 k : {2, 4}) {
+        check_operator(Gradient(k, m, n, dx, dy),
+                       MatrixFreeGradient(k, m, n, dx, dy));
+        check_operator(Divergence(k, m, n, dx, dy),
+                       MatrixFreeDivergence(k, m, n, dx, dy));
+        check_operator(Laplacian(k, m, n, o, dx, dy, dz),
+                       MatrixFreeLaplacian(k, m, n, o, dx, dy, dz));
+        check_operator(Laplacian(k, m, n, o, dx, dy, dz),
+                       PeriodicLaplacian(k, m, n, o, dx, dy, dz, false, false, false));
+    }
+}
+
+TEST(PeriodicTests, Circulant) {
+    u16 k = 4;
+    u32 m = 32;
+    Real dx = 1.0 / m;
+    PeriodicGradient G(k, m, dx);
+    PeriodicDivergence D(k, m, dx);
+    PeriodicLaplacian L(k, m, dx);
+
+    // Face i is the left face of cell i
+    vec xc = linspace(dx / 2, 1 - dx / 2, m), xf = linspace(0, 1 - dx, m);
+    vec u = sin(2 * M_PI * xc), g, Lu;
+    G.apply(u, g);
+    EXPECT_LT(abs(g - 2 * M_PI * cos(2 * M_PI * xf)).max(), 1e-3);
+
+    // D = -G' and L = D*G
+    vec v = randu<vec>(m), Dv, Gv;
+    D.apply(v, Dv);
+    EXPECT_NEAR(dot(Dv, u), -dot(v, g), 1e-10);
+
+    L.apply(u, Lu);
+    D.apply(g, Dv);
+    EXPECT_LT(norm(Lu - Dv), 1e-10 * norm(Lu));
+
+    // Constants are in the null space of the periodic Laplacian
+    L.apply(vec(m, fill::ones), Lu);
+    EXPECT_LT(abs(Lu).max(), 1e-10);
+}
+
+TEST(PeriodicTests, MixedAxes) {
+    u16 k = 2;
+    u32 m = 12, n = 10, o = 8;
+    Real dx = 1.0 / m, dy = 1.0 / n, dz = 1.0 / o;
+
+    // Periodic in x and z, walls in y: (m)(n + 2)(o) unknowns
+    PeriodicGradient G(k, m, n, o, dx, dy, dz, true, false, true);
+    PeriodicDivergence D(k, m, n, o, dx, dy, dz, true, false, true);
+    PeriodicLaplacian L(k, m, n, o, dx, dy, dz, true, false, true);
+
+    ASSERT_EQ(G.n_cols(), m * (n + 2) * o);
+    ASSERT_EQ(G.n_rows(), m * n * o + m * (n + 1) * o + m * n * o);
+    ASSERT_EQ(D.n_cols(), G.n_rows());
+
+    vec u = randu<vec>(G.n_cols()), g, DGu, Lu;
+    G.apply(u, g);
+    D.apply(g, DGu);
+    L.apply(u, Lu);
+    EXPECT_LT(norm(Lu - DGu), 1e-10 * norm(Lu));
+
+    // Solve -L u = f with a Krylov method, u = 0 on the walls
+    vec f(L.n_rows(), fill::zeros), x(L.n_rows(), fill::zeros);
+    auto A = [&](const vec &v, vec &Av) {
+        L.apply(v, Av);
+        Av = -Av;
+        for (u32 l = 0; l < o; ++l)
+            for (u32 i = 0; i < m; ++i) {
+                uword s = i + m * (n + 2) * l;
+                Av(s) = v(s);
+                Av(s + m * (n + 1)) = v(s + m * (n + 1));
+            }
+    };
+    for (u32 l = 0; l < o; ++l)
+        for (u32 j = 1; j <= n; ++j)
+            for (u32 i = 0; i < m; ++i)
+                f(i + m * (j + (n + 2) * l)) = 1;
+    KrylovInfo info = Krylov::bicgstab(A, f, x);
+    EXPECT_TRUE(info.converged);
+}
+
+TEST(PeriodicTests, TiledApplyMatchesSweep) {
+    u32 m = 23, n = 17, o = 13;
+    Real dx = 0.1, dy = 0.2, dz = 0.3;
+
+    for (u16 k : {2, 4}) {
+        MatrixFreeGradient G(k, m, n, o, dx, dy, dz);
+        PeriodicDivergence D(k, m, n, o, dx, dy, dz, true, false, true);
+        PeriodicLaplacian L(k, m, n, o, dx, dy, dz, false, true, false);
+
+        for (MatrixFreeOperator *P : {(MatrixFreeOperator *)&G, (MatrixFreeOperator *)&D,
+                                      (MatrixFreeOperator *)&L}) {
+            vec x = randu<vec>(P->n_cols()), y, z;
+            P->apply(x, y);
+
+            // Tiles that divide the grid or not, thinner than the stencil
+            // or wider than the grid
+            for (auto t : std::vector<std::array<u32, 3>>{
+                     {3, 5, 7}, {1, 1, 1}, {64, 4, 4}, {5, 100, 2}}) {
+                P->set_tiles(t[0], t[1], t[2]);
+                P->apply(x, z);
+                EXPECT_LT(norm(z - y), 1e-14 * norm(y));
+            }
+
+            P->autotune(1);
+            P->apply(x, z);
+            EXPECT_LT(norm(z - y), 1e-14 * norm(y));
+        }
+    }
+}
@@ -0,0 +1,56 @@
+#include "mole.h"
+#include <gtest/gtest.h>
+
+TEST(NodalTests, ExactOnPolynomials) {
+    u32 m = 12;
+    Real dx = 0.25;
+    vec x = linspace(0, m * dx, m + 1);
+
+    for (u16 k : {2, 4, 6}) {
+        Nodal N(k, m, dx);
+        for (int p = 0; p <= k; ++p) {
+            vec u = pow(x, p), du = N * u;
+            vec exact = p ? p * pow(x, p - 1) : vec(m + 1, fill::zeros);
+            EXPECT_LT(abs(du - exact).max(), 1e-8 * std::pow(m * dx, p)) << "k = " << k << ", p = " << p;
+        }
+    }
+}
+
+TEST(NodalTests, MatrixFreeMatchesAssembled) {
+    u32 m = 10, n = 8, o = 7;
+    Real dx = 0.1, dy = 0.2, dz = 0.3;
+
+    for (u16 k : {2, 4}) {
+        Nodal N(k, m, n, o, dx, dy, dz);
+        cube u = randu<cube>(m + 1, n + 1, o + 1), du;
+        vec Nu = N * vectorise(u);
+
+        uword size = u.n_elem;
+        Real h[3] = {dx, dy, dz};
+        for (u16 a = 0; a < 3; ++a) {
+            Nodal::apply(k, u, du, a, h[a]);
+            vec block = Nu.subvec(a * size, (a + 1) * size - 1);
+            EXPECT_LT(norm(vectorise(du) - block), 1e-10 * norm(block));
+        }
+    }
+}
+
+TEST(NodalTests, SidedWrapsAround) {
+    u32 m = 16;
+    Real dx = 1.0 / m;
+    vec x = linspace(0, 1, m + 1), u = sin(2 * M_PI * x), du;
+
+    for (auto type : {SidedNodal::BACKWARD, SidedNodal::FORWARD, SidedNodal::CENTERED}) {
+        SidedNodal S(m, dx, type);
+        SidedNodal::apply(u, du, dx, type);
+        EXPECT_LT(norm(du - S * u), 1e-12);
+
+        // Periodic: both copies of node 0 get the same derivative, and
+        // constants are in the null space
+        EXPECT_NEAR(du(0), du(m), 1e-12);
+        EXPECT_LT(abs(S * vec(m + 1, fill::ones)).max(), 1e-12);
+    }
+
+    SidedNodal C(m, dx);
+    EXPECT_LT(abs(C * u - 2 * M_PI * cos(2 * M_PI * x)).max(), 0.2);
+}
@@ -0,0 +1,69 @@
+#include "mole.h"
+#include <gtest/gtest.h>
+
+TEST(MimeticTests, ReproducesTables) {
+    for (u16 k : {2, 4, 6, 8}) {
+        const MimeticStencils &s = Mimetic::stencils(k);
+        u32 m = 2 * k;
+        Gradient G(k, m, 1.0);
+
+        for (u32 r = 0; r < k / 2u; ++r)
+            for (u32 c = 0; c <= k; ++c)
+                EXPECT_NEAR(G(r, c), s.gradient[r][c], 1e-12);
+        for (u32 c = 0; c < k; ++c)
+            EXPECT_NEAR(G(k / 2, c + 1), s.interior[c], 1e-12);
+
+        // The tabled weights are rational approximations
+        vec P = G.getP();
+        ASSERT_EQ(P.n_elem, s.P.size());
+        for (uword i = 0; i < P.n_elem; ++i)
+            EXPECT_NEAR(P(i), s.P[i], 1e-6);
+
+        Divergence D(k, m + 1, 1.0);
+        for (u32 r = 0; r + 1 < k / 2u; ++r)
+            for (u32 c = 0; c <= k; ++c)
+                EXPECT_NEAR(D(r + 1, c), s.divergence[r][c], 1e-12);
+
+        vec Q = D.getQ();
+        ASSERT_EQ(Q.n_elem, s.Q.size());
+        for (uword i = 0; i < Q.n_elem; ++i)
+            EXPECT_NEAR(Q(i), s.Q[i], 1e-6);
+    }
+}
+
+TEST(MimeticTests, HighOrderExactOnPolynomials) {
+    for (u16 k : {10, 12}) {
+        u32 m = 2 * k + 1;
+        Real dx = 1.0 / m;
+        Gradient G(k, m, dx);
+        Divergence D(k, m, dx);
+
+        vec xc(m + 2), xf = linspace(0, 1, m + 1);
+        xc(0) = 0;
+        xc(m + 1) = 1;
+        xc.subvec(1, m) = linspace(dx / 2, 1 - dx / 2, m);
+
+        // Exact up to degree k - 1 at every row
+        for (int p = 1; p < k; ++p) {
+            vec g = G * pow(xc, p), d = D * pow(xf, p);
+            EXPECT_LT(abs(g - p * pow(xf, p - 1)).max(), 1e-7) << "k = " << k << ", p = " << p;
+            vec exact = p * pow(xc, p - 1);
+            exact(0) = exact(m + 1) = 0;
+            EXPECT_LT(abs(d - exact).max(), 1e-7) << "k = " << k << ", p = " << p;
+        }
+    }
+}
+
+TEST(MimeticTests, WeightsSatisfyGaussTheorem) {
+    u16 k = 10;
+    const MimeticStencils &s = Mimetic::stencils(k);
+    u32 m = 2 * k;
+    Gradient G(k, m, 1.0);
+
+    // G'P = [-1 0 ... 0 1]'
+    vec b = sp_mat(G.t()) * conv_to<vec>::from(s.P);
+    vec e(m + 2, fill::zeros);
+    e(0) = -1;
+    e(m + 1) = 1;
+    EXPECT_LT(abs(b - e).max(), 1e-10);
+}
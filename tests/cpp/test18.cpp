@@ -0,0 +1,118 @@
+#include "mole.h"
+#include <gtest/gtest.h>
+
+// Cells within 0.05 of the circle of radius 0.25 around the center
+AMR::Criterion front = [](const Patch &p, u32 i, u32 j) {
+    Real x = p.grid.xc()(i) - 0.5, y = p.grid.yc()(j) - 0.5;
+    return std::abs(std::sqrt(x * x + y * y) - 0.25) < 0.05;
+};
+
+TEST(AMRTests, PatchesAreNested) {
+    u16 k = 2;
+    AMR amr(k, 32, 32, 0, 1, 0, 1, 2);
+    amr.regrid(front);
+
+    ASSERT_EQ(amr.n_levels(), 3);
+    for (u16 l = 1; l < amr.n_levels(); ++l) {
+        for (const Patch &p : amr.level(l)) {
+            const Patch &q = amr.level(l - 1)[p.parent];
+            EXPECT_EQ(p.level, l);
+            EXPECT_GE(p.grid.m, 2u * k + 1);
+            EXPECT_GE(p.grid.n, 2u * k + 1);
+            EXPECT_GE(p.i0 / 2, q.i0);
+            EXPECT_GE(p.j0 / 2, q.j0);
+            EXPECT_LE((p.i0 + p.grid.m) / 2, q.i0 + q.grid.m);
+            EXPECT_LE((p.j0 + p.grid.n) / 2, q.j0 + q.grid.n);
+            EXPECT_NEAR(p.grid.dx, q.grid.dx / 2, 1e-14);
+        }
+    }
+
+    // Fewer cells than the finest level everywhere
+    EXPECT_LT(amr.n_cells(), 128u * 128u);
+}
+
+TEST(AMRTests, LinearFieldsAreReproduced) {
+    AMR amr(2, 20, 16, 0, 2, -1, 1, 2);
+    auto f = [](Real x, Real y) { return 1 + 2 * x - 3 * y; };
+
+    Patch &b = amr.base();
+    vec x = b.grid.xc(), y = b.grid.yc();
+    Field U = b.grid.centers(b.u);
+    for (u32 j = 0; j < y.n_elem; ++j)
+        for (u32 i = 0; i < x.n_elem; ++i)
+            U(i, j) = f(x(i), y(j));
+
+    amr.regrid([](const Patch &p, u32 i, u32 j) {
+        return p.grid.xc()(i) < 0.5 && p.grid.yc()(j) > 0;
+    });
+    ASSERT_GT(amr.n_levels(), 1);
+
+    for (u16 l = 1; l < amr.n_levels(); ++l) {
+        amr.fill(l);
+        for (Patch &p : amr.level(l)) {
+            vec px = p.grid.xc(), py = p.grid.yc();
+            Field V = p.grid.centers(p.u);
+            for (u32 j = 0; j < py.n_elem; ++j)
+                for (u32 i = 0; i < px.n_elem; ++i)
+                    EXPECT_NEAR(V(i, j), f(px(i), py(j)), 1e-12);
+
+            // The Laplacian of a linear field vanishes
+            EXPECT_LT(abs(amr.laplacian(p) * p.u).max(), 1e-9);
+        }
+    }
+
+    // So it is a steady state of diffusion on every level
+    vec before = amr.base().u;
+    Real dx = amr.level(amr.n_levels() - 1)[0].grid.dx;
+    for (int s = 0; s < 5; ++s)
+        amr.diffuse(1.0, 0.1 * dx * dx);
+    EXPECT_LT(abs(amr.base().u - before).max(), 1e-10);
+}
+
+TEST(AMRTests, AveragingDownIsConservative) {
+    AMR amr(2, 24, 24, 0, 1, 0, 1, 2);
+    Patch &b = amr.base();
+    b.u = randu<vec>(b.u.n_elem);
+    vec before = b.u;
+
+    amr.regrid(front);
+    ASSERT_GT(amr.n_levels(), 1);
+
+    // Prolongation keeps the parent averages
+    amr.average_down();
+    EXPECT_LT(abs(amr.base().u - before).max(), 1e-12);
+}
+
+TEST(AMRTests, RefluxingConservesMass) {
+    AMR amr(2, 24, 24, 0, 1, 0, 1, 2);
+    amr.efficiency = 0.9;
+
+    // A bump that is negligible on the domain boundary
+    Patch &b = amr.base();
+    vec x = b.grid.xc(), y = b.grid.yc();
+    Field U = b.grid.centers(b.u);
+    for (u32 j = 0; j < y.n_elem; ++j)
+        for (u32 i = 0; i < x.n_elem; ++i)
+            U(i, j) = std::exp(-200 * ((x(i) - 0.5) * (x(i) - 0.5) +
+                                       (y(j) - 0.5) * (y(j) - 0.5)));
+
+    // An L-shaped region, split into patches that touch, whose interfaces
+    // cross the bump
+    amr.regrid([](const Patch &p, u32 i, u32 j) {
+        return p.grid.xc()(i) < 0.5 || p.grid.yc()(j) < 0.5;
+    });
+    ASSERT_EQ(amr.n_levels(), 3);
+    ASSERT_GT(amr.level(1).size(), 1u);
+
+    auto mass = [&amr] {
+        Patch &b = amr.base();
+        mat V = b.grid.centers(b.u).as_mat();
+        return accu(V.submat(1, 1, b.grid.m, b.grid.n)) * b.grid.dx * b.grid.dy;
+    };
+
+    Real before = mass();
+    Real dx = amr.level(2)[0].grid.dx;
+    for (int s = 0; s < 10; ++s)
+        amr.diffuse(1.0, 0.1 * dx * dx);
+    EXPECT_NEAR(mass(), before, 1e-13 * before);
+}
@@ -0,0 +1,149 @@
+#include "mole.h"
+#include <gtest/gtest.h>
+
+#ifdef MOLE_USE_MPI
+
+// Applies op to the same random vector on every rank and compares the
+// gathered result with the assembled operator
+void check_operator(const sp_mat &A, const DistributedOperator &op) {
+    arma_rng::set_seed(19);
+    vec u = randu<vec>(A.n_cols);
+
+    DistributedField x = op.domain(), y = op.range();
+    x.scatter(u);
+    op.apply(x, y);
+    vec v = y.gather();
+
+    ASSERT_EQ(v.n_elem, A.n_rows);
+    EXPECT_LT(abs(v - A * u).max(), 1e-10 * abs(A * u).max());
+}
+
+TEST(DistributedTests, OperatorsMatchAssembled) {
+    u32 m = 12, n = 10, o = 9;
+    Real dx = 0.1, dy = 0.2, dz = 0.3;
+
+    for (u16 k : {2, 4}) {
+        Partition p(MPI_COMM_WORLD, k, m, n, o);
+        check_operator(Gradient(k, m, n, o, dx, dy, dz),
+                       DistributedGradient(p, dx, dy, dz));
+        check_operator(Divergence(k, m, n, o, dx, dy, dz),
+                       DistributedDivergence(p, dx, dy, dz));
+        check_operator(Interpol(m, n, o, 0.3, 0.4, 0.6),
+                       DistributedInterpol(p, 0.3, 0.4, 0.6));
+        check_operator(Interpol(true, m, n, o, 0.3, 0.4, 0.6),
+                       DistributedInterpol(true, p, 0.3, 0.4, 0.6));
+    }
+}
+
+TEST(DistributedTests, LaplacianMatchesAssembled) {
+    u16 k = 4;
+    u32 m = 12, n = 10, o = 9;
+    Partition p(MPI_COMM_WORLD, k, m, n, o);
+    Laplacian A(k, m, n, o, 1.0 / m, 1.0 / n, 1.0 / o);
+    DistributedLaplacian L(p, 1.0 / m, 1.0 / n, 1.0 / o);
+
+    arma_rng::set_seed(19);
+    vec u = randu<vec>(A.n_cols);
+    DistributedField x(p), y(p);
+    x.scatter(u);
+    L.apply(x, y);
+    EXPECT_LT(abs(y.gather() - A * u).max(), 1e-10 * abs(A * u).max());
+
+    // Every entry is owned exactly once
+    EXPECT_NEAR(x.dot(x), dot(u, u), 1e-10 * dot(u, u));
+    unsigned long long owned = x.n_owned();
+    MPI_Allreduce(MPI_IN_PLACE, &owned, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, p.comm);
+    EXPECT_EQ(owned, u.n_elem);
+}
+
+TEST(DistributedTests, GhostsComeFromNeighbors) {
+    u16 k = 4;
+    Partition p(MPI_COMM_WORLD, k, 12, 10, 9);
+    DistributedField f(p);
+    const Block &b = f.blocks[0];
+
+    // Every entry holds its global index
+    vec index = regspace<vec>(0, b.global[0] * b.global[1] * b.global[2] - 1);
+    f.scatter(index);
+    f.begin_exchange();
+    f.end_exchange();
+
+    for (u16 a = 0; a < 3; ++a) {
+        if (!b.lo[a])
+            continue;
+        uword g[3] = {b.start[0], b.start[1], b.start[2]};
+        g[a] -= b.lo[a];
+        EXPECT_EQ(f.values(b.at(g[0], g[1], g[2])),
+                  (Real)(g[0] + b.global[0] * (g[1] + b.global[1] * g[2])));
+    }
+}
+
+TEST(DistributedTests, PoissonSolveMatchesSerial) {
+    u16 k = 2;
+    u32 m = 12, n = 10, o = 9;
+    Real dx = 1.0 / m, dy = 1.0 / n, dz = 1.0 / o;
+    Partition p(MPI_COMM_WORLD, k, m, n, o);
+
+    // Dirichlet on every face
+    DistributedPoisson A(p, dx, dy, dz, 1, 0);
+    sp_mat S = Laplacian(k, m, n, o, dx, dy, dz);
+    S += RobinBC(k, m, dx, n, dy, o, dz, 1, 0);
+
+    arma_rng::set_seed(19);
+    vec f = randu<vec>(S.n_rows);
+    vec exact = LinearSolver::spsolve(S, f);
+
+    DistributedField rhs(p), u(p);
+    rhs.scatter(f);
+    vec b = rhs.pack(), x;
+    BlockJacobi M(A.local());
+    KrylovInfo info =
+        DistributedKrylov::gmres(p.comm, A.op(), b, x, M.preconditioner(), 1e-12);
+    ASSERT_TRUE(info.converged);
+
+    u.unpack(x);
+    EXPECT_LT(abs(u.gather() - exact).max(), 1e-8 * abs(exact).max());
+
+    // A single rank solves exactly in one step
+    if (p.size == 1) {
+        EXPECT_EQ(info.iterations, 1u);
+    }
+}
+
+TEST(DistributedTests, ConjugateGradientMatchesSerial) {
+    Partition p(MPI_COMM_WORLD, 2, 12, 10, 9);
+    DistributedField f(p);
+    uword N = f.blocks[0].global[0] * f.blocks[0].global[1] * f.blocks[0].global[2];
+
+    // An SPD diagonal operator with 20 distinct eigenvalues
+    vec d(N);
+    for (uword i = 0; i < N; ++i)
+        d(i) = 1 + i % 20;
+    arma_rng::set_seed(19);
+    vec b = randu<vec>(N);
+
+    f.scatter(d);
+    vec dl = f.pack();
+    f.scatter(b);
+    vec bl = f.pack(), xl;
+    KrylovInfo info = DistributedKrylov::cg(
+        p.comm, [&](const vec &x, vec &y) { y = dl % x; }, bl, xl);
+
+    vec x;
+    KrylovInfo serial = Krylov::cg([&](const vec &x, vec &y) { y = d % x; }, b, x);
+    EXPECT_EQ(info.iterations, serial.iterations);
+
+    f.unpack(xl);
+    EXPECT_LT(abs(f.gather() - b / d).max(), 1e-8);
+}
+
+// Runs on any number of ranks, see tests/cpp/CMakeLists.txt
+int main(int argc, char **argv) {
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleTest(&argc, argv);
+    int result = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return result;
+}
+
+#endif
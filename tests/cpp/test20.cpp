@@ -0,0 +1,54 @@
+#include "mole.h"
+#include <gtest/gtest.h>
+
+TEST(NUMATests, FieldsAreZeroedAndCopied) {
+    vec z = NUMA::zeros(100000);
+    ASSERT_EQ(z.n_elem, 100000u);
+    EXPECT_EQ(abs(z).max(), 0.0);
+
+    // Resized or reused in place
+    vec y = randu<vec>(10);
+    NUMA::zeros(y, 10);
+    EXPECT_EQ(abs(y).max(), 0.0);
+    NUMA::zeros(y, 5000);
+    ASSERT_EQ(y.n_elem, 5000u);
+    EXPECT_EQ(abs(y).max(), 0.0);
+
+    vec x = randu<vec>(12345);
+    EXPECT_EQ(abs(NUMA::copy(x) - x).max(), 0.0);
+
+    for (int n : NUMA::thread_nodes())
+        EXPECT_GE(n, 0);
+}
+
+TEST(NUMATests, MatrixMatchesSpMV) {
+    u16 k = 4;
+    u32 m = 12, n = 10, o = 8;
+    Laplacian L(k, m, n, o, 1.0 / m, 1.0 / n, 1.0 / o);
+    Gradient G(k, m, n, o, 1.0 / m, 1.0 / n, 1.0 / o);
+
+    for (const sp_mat *A : {(const sp_mat *)&L, (const sp_mat *)&G}) {
+        NumaMatrix N(*A);
+        EXPECT_EQ(N.n_rows(), A->n_rows);
+        EXPECT_EQ(N.n_cols(), A->n_cols);
+        EXPECT_EQ(N.n_nonzero(), A->n_nonzero);
+
+        vec x = randu<vec>(A->n_cols), y;
+        N.apply(x, y);
+        vec z = (*A) * x;
+        EXPECT_LT(norm(y - z), 1e-12 * norm(z));
+    }
+}
+
+TEST(NUMATests, MatrixFreeApplyReusesOutput) {
+    u32 m = 10;
+    Real dx = 1.0 / m;
+    Laplacian A(2, m, m, m, dx, dx, dx);
+    MatrixFreeLaplacian P(2, m, m, m, dx, dx, dx);
+
+    // A stale output of the right size is overwritten, not accumulated
+    vec x = randu<vec>(A.n_cols), y = randu<vec>(A.n_rows);
+    P.apply(x, y);
+    vec z = A * x;
+    EXPECT_LT(norm(y - z), 1e-10 * norm(z));
+}
@@ -27,11 +27,7 @@ void run_test(int k, vec grid_sizes) {
         U(0) = 0;              // West BC
         U(m + 1) = 2 * exp(1); // East BC
 
-#ifdef EIGEN
-        vec computed_solution = Utils::spsolve_eigen(L, U);
-#else
-        vec computed_solution = spsolve(L, U); // Will use SuperLU
-#endif
+        vec computed_solution = LinearSolver::spsolve(L, U);
 
         vec analytical_solution = exp(grid);
         errors(i) = max(abs(computed_solution - analytical_solution));
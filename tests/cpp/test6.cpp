@@ -0,0 +1,110 @@
+#include "mole.h"
+#include <gtest/gtest.h>
+
+vec staggered_grid(int m, Real dx) {
+    vec grid(m + 2);
+    grid(0) = 0;
+    for (int j = 1; j <= m; j++) {
+        grid(j) = (j - 0.5) * dx;
+    }
+    grid(m + 1) = m * dx;
+    return grid;
+}
+
+TEST(WeightedLaplacianTests, Symmetry) {
+    Real tol = 1e-10;
+    for (int k : {2, 4, 6}) {
+        int m = 2 * k + 2;
+        WeightedLaplacian S1(k, m, 1.0 / m, 1, 1);
+        WeightedLaplacian S2(k, m, 1.0 / m, m + 1, 1.0 / (m + 1), 1, 0);
+        WeightedLaplacian S3(k, m, 1.0 / m, m, 1.0 / m, m, 1.0 / m, 1, 1);
+
+        EXPECT_LT(norm((sp_mat)S1 - ((sp_mat)S1).t(), "fro"), tol);
+        EXPECT_LT(norm((sp_mat)S2 - ((sp_mat)S2).t(), "fro"), tol);
+        EXPECT_LT(norm((sp_mat)S3 - ((sp_mat)S3).t(), "fro"), tol);
+    }
+}
+
+TEST(WeightedLaplacianTests, RobinAccuracy1D) {
+    vec grid_sizes = {20, 40};
+    for (int k : {2, 4, 6}) {
+        vec errors(grid_sizes.size());
+
+        for (int i = 0; i < grid_sizes.size(); ++i) {
+            int m = grid_sizes(i);
+            Real dx = 1.0 / m;
+            vec grid = staggered_grid(m, dx);
+
+            WeightedLaplacian S(k, m, dx, 1, 1);
+
+            vec f = exp(grid);
+            f(0) = 0;              // West BC
+            f(m + 1) = 2 * exp(1); // East BC
+
+            KrylovInfo info;
+            vec u = S.solve(f, 1e-11, 0, &info);
+            ASSERT_TRUE(info.converged) << "CG failed for k = " << k;
+
+            errors(i) = max(abs(u - exp(grid)));
+        }
+
+        ASSERT_GE(log2(errors(0) / errors(1)), 1.5)
+            << "Weighted Robin Test failed for k = " << k;
+    }
+}
+
+TEST(WeightedLaplacianTests, DirichletAccuracy2D) {
+    for (int k : {2, 4}) {
+        vec errors(2);
+
+        for (int i = 0; i < 2; ++i) {
+            int m = 16 * (i + 1);
+            int n = m + 3;
+            Real dx = 1.0 / m;
+            Real dy = 1.0 / n;
+            vec x = staggered_grid(m, dx);
+            vec y = staggered_grid(n, dy);
+
+            WeightedLaplacian S(k, m, dx, n, dy, 1, 0);
+
+            // u = exp(x + y), so Lu = 2u and u is the Dirichlet data
+            vec exact = vectorise(exp(repmat(x, 1, n + 2) + repmat(y.t(), m + 2, 1)));
+            vec f = exact;
+            for (int j = 1; j <= n; ++j)
+                f.subvec(j * (m + 2) + 1, j * (m + 2) + m) *= 2;
+
+            KrylovInfo info;
+            vec u = S.solve(f, 1e-11, 0, &info);
+            ASSERT_TRUE(info.converged) << "CG failed for k = " << k;
+
+            errors(i) = max(abs(u - exact));
+        }
+
+        ASSERT_GE(log2(errors(0) / errors(1)), 1.5)
+            << "Weighted Dirichlet Test failed for k = " << k;
+    }
+}
+
+TEST(WeightedLaplacianTests, DiffersFromLaplacianPlusRobinBCAtBoundary) {
+    // Rows from either end where the dropped boundary operator acts
+    const std::vector<std::pair<int, int>> bands = {{2, 3}, {4, 9}, {6, 12}};
+
+    for (auto kb : bands) {
+        int k = kb.first, band = kb.second;
+        int m = 40;
+        Real dx = 1.0 / m;
+        vec f = exp(staggered_grid(m, dx));
+
+        WeightedLaplacian S(k, m, dx, 1, 1);
+        KrylovInfo info;
+        vec u = S.solve(f, 1e-13, 0, &info);
+        ASSERT_TRUE(info.converged) << "CG failed for k = " << k;
+
+        sp_mat A = Laplacian(k, m, dx) + RobinBC(k, m, dx, 1, 1);
+        vec r = A * u - f;
+        EXPECT_LT(max(abs(r.subvec(band, m + 1 - band))), 1e-7 * max(abs(f)))
+            << "Interior residual for k = " << k;
+        EXPECT_GT(max(abs(r)), 1e-4 * max(abs(f)))
+            << "Boundary residual for k = " << k;
+    }
+}
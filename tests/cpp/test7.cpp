@@ -0,0 +1,84 @@
+#include "mole.h"
+#include <gtest/gtest.h>
+
+sp_mat oscillator_1d(int k, int m) {
+    vec grid = linspace(-5, 5, m);
+    Real dx = grid(1) - grid(0);
+
+    Laplacian L(k, m - 2, dx);
+
+    sp_mat V(m, m);
+    V.diag(0) = square(grid);
+
+    return -0.5 * (sp_mat)L + V;
+}
+
+TEST(EigensolverTests, Oscillator1D) {
+    // Fourth order discretization error of the energy ratios, < 7e-7
+    Real tol = 1e-6;
+    sp_mat H = oscillator_1d(4, 500);
+
+    Eigensolver eigs(H);
+
+    cx_vec eigval;
+    cx_mat eigvec;
+    EigenInfo info = eigs.solve(eigval, eigvec, 5);
+
+    ASSERT_EQ(info.converged, 5u);
+
+    vec expected{1, 3, 5, 7, 9};
+
+    for (int i = 0; i < expected.size(); ++i) {
+        ASSERT_NEAR(real(eigval(i) / eigval(0)), expected(i), tol)
+            << "Energy Test failed for eigenvalue index " << i;
+
+        vec x = real(eigvec.col(i));
+        ASSERT_LT(norm(H * x - real(eigval(i)) * x), 1e-6 * std::abs(eigval(i)))
+            << "Eigenvector Test failed for eigenvalue index " << i;
+    }
+}
+
+TEST(EigensolverTests, Oscillator2D) {
+    int k = 4;
+    int m = 60;
+    Real dx = 10.0 / m;
+
+    vec grid(m + 2);
+    grid(0) = -5;
+    grid.subvec(1, m) = linspace(-5 + dx / 2, 5 - dx / 2, m);
+    grid(m + 1) = 5;
+
+    Laplacian L(k, m, m, dx, dx);
+
+    mat X, Y;
+    Utils utils;
+    utils.meshgrid(grid, grid, X, Y);
+
+    sp_mat V((m + 2) * (m + 2), (m + 2) * (m + 2));
+    V.diag(0) = vectorise(square(X) + square(Y));
+
+    sp_mat H = -0.5 * (sp_mat)L + V;
+
+    cx_vec eigval = Eigensolver(H).eigenvalues(6);
+
+    // E = sqrt(2)(nx + ny + 1)
+    vec expected{1, 2, 2, 3, 3, 3};
+
+    for (int i = 0; i < expected.size(); ++i) {
+        ASSERT_NEAR(real(eigval(i) / eigval(0)), expected(i), 1e-2)
+            << "2D Energy Test failed for eigenvalue index " << i;
+    }
+}
+
+TEST(EigensolverTests, Generalized) {
+    sp_mat H = oscillator_1d(2, 200);
+    sp_mat B = 2 * speye(200, 200);
+
+    cx_vec standard = Eigensolver(H, 0.5).eigenvalues(4);
+    cx_vec generalized = Eigensolver(H, B, 0.25).eigenvalues(4);
+
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_NEAR(real(generalized(i)), real(standard(i)) / 2, 1e-8)
+            << "Generalized Test failed for eigenvalue index " << i;
+    }
+}
@@ -0,0 +1,156 @@
+#include "mole.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+
+sp_mat poisson_1d(int k, int m) {
+    Laplacian L(k, m, 1.0 / m);
+    RobinBC BC(k, m, 1.0 / m, 1, 1);
+
+    return L + BC;
+}
+
+bool registered(const std::string &name) {
+    std::vector<std::string> names = LinearSolver::backends();
+    return std::find(names.begin(), names.end(), name) != names.end();
+}
+
+TEST(SolverTests, DirectBackends) {
+    sp_mat A = poisson_1d(4, 40);
+    vec b = linspace(0, 1, A.n_rows);
+
+    vec reference = LinearSolver::spsolve(A, b, "eigen-lu");
+
+    for (std::string name : {"superlu", "eigen-lu"}) {
+        if (!registered(name))
+            continue;
+
+        auto solver = LinearSolver::create(name);
+        solver->factorise(A);
+
+        // The factorization is reused
+        for (int i = 0; i < 2; ++i) {
+            vec x = solver->solve((i + 1) * b);
+            ASSERT_LT(norm(x - (i + 1) * reference), 1e-8 * norm(reference))
+                << "Backend " << name << " failed";
+        }
+
+        ASSERT_EQ(solver->stats().iterations, 0);
+    }
+
+    auto lu = LinearSolver::create("eigen-lu");
+    lu->factorise(A);
+    ASSERT_GE(lu->stats().fill, A.n_nonzero);
+}
+
+TEST(SolverTests, IterativeBackends) {
+    sp_mat A = poisson_1d(2, 40);
+    vec b = linspace(0, 1, A.n_rows);
+
+    vec reference = LinearSolver::spsolve(A, b, "eigen-lu");
+
+    SolverOptions opts;
+    opts.tol = 1e-12;
+    opts.maxit = 500;
+    opts.restart = 100;
+
+    auto solver = LinearSolver::create("gmres", opts);
+    solver->factorise(A);
+    vec x = solver->solve(b);
+
+    ASSERT_LT(norm(x - reference), 1e-6 * norm(reference));
+    ASSERT_GT(solver->stats().iterations, 0);
+    ASSERT_LE(solver->stats().residual, opts.tol);
+}
+
+TEST(SolverTests, MixedPrecision) {
+    int m = 20;
+    Laplacian L(2, m, m, m, 1.0 / m, 1.0 / m, 1.0 / m);
+    RobinBC BC(2, m, 1.0 / m, m, 1.0 / m, m, 1.0 / m, 1, 0);
+    sp_mat A = L + BC;
+    vec b = linspace(0, 1, A.n_rows);
+
+    vec reference = LinearSolver::spsolve(A, b, "eigen-lu");
+
+    SolverOptions opts;
+    opts.tol = 1e-12;
+
+    auto solver = LinearSolver::create("mixed", opts);
+    solver->factorise(A);
+    vec x = solver->solve(b);
+
+    ASSERT_LE(solver->stats().residual, opts.tol);
+    ASSERT_GT(solver->stats().iterations, 0);
+    ASSERT_LT(norm(x - reference), 1e-9 * norm(reference));
+
+    auto lu = LinearSolver::create("eigen-lu");
+    lu->factorise(A);
+    ASSERT_LT(solver->stats().bytes, lu->stats().bytes);
+}
+
+TEST(SolverTests, SymmetricBackends) {
+    WeightedLaplacian S(4, 30, 1.0 / 30, 1, 1);
+    vec b = linspace(1, 2, S.n_rows);
+
+    vec reference = LinearSolver::spsolve(S, b, "eigen-lu");
+
+    for (std::string name : {"eigen-ldlt", "cg"}) {
+        vec x = LinearSolver::spsolve(S, b, name);
+        ASSERT_LT(norm(x - reference), 1e-6 * norm(reference))
+            << "Backend " << name << " failed";
+    }
+}
+
+TEST(SolverTests, Registry) {
+    ASSERT_THROW(LinearSolver::create("no-such-solver"), std::invalid_argument);
+
+    LinearSolver::add("custom", [](const SolverOptions &opts) {
+        return LinearSolver::create("bicgstab", opts);
+    });
+    ASSERT_TRUE(registered("custom"));
+
+    sp_mat A = poisson_1d(2, 20);
+    vec b(A.n_rows, fill::ones);
+
+    SolverOptions opts;
+    opts.maxit = 1000;
+    auto solver = LinearSolver::create("custom", opts);
+    solver->factorise(A);
+    vec x = solver->solve(b);
+
+    ASSERT_LT(norm(A * x - b), 1e-6 * norm(b));
+}
+
+TEST(SolverTests, Batched) {
+    sp_mat A = poisson_1d(4, 40);
+
+    mat B(A.n_rows, 12);
+    for (uword c = 0; c < B.n_cols; ++c)
+        B.col(c) = linspace(0, c + 1, A.n_rows);
+
+    SolverOptions opts;
+    opts.restart = 100;
+
+    for (std::string name : {"superlu", "eigen-lu", "mixed", "gmres"}) {
+        if (!registered(name))
+            continue;
+
+        auto solver = LinearSolver::create(name, opts);
+        solver->factorise(A);
+
+        for (u32 block : {0, 1, 5}) {
+            mat X;
+            solver->solve(B, X, block);
+            ASSERT_EQ(X.n_cols, B.n_cols);
+
+            for (uword c = 0; c < B.n_cols; ++c) {
+                vec x = solver->solve(vec(B.col(c)));
+                ASSERT_LT(norm(X.col(c) - x), 1e-8 * norm(x))
+                    << "Backend " << name << " failed for column " << c;
+            }
+        }
+    }
+
+    mat X;
+    LinearSolver::spsolve(A, B, X);
+    ASSERT_LT(norm(A * X - B, "fro"), 1e-8 * norm(B, "fro"));
+}
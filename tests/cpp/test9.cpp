@@ -0,0 +1,94 @@
+#include "mole.h"
+#include <gtest/gtest.h>
+
+sp_mat dirichlet_2d(int k, int m, int n) {
+    Laplacian L(k, m, n, 1.0 / m, 1.0 / n);
+    RobinBC BC(k, m, 1.0 / m, n, 1.0 / n, 1, 0);
+
+    return L + BC;
+}
+
+TEST(SchwarzTests, Partitions) {
+    int m = 10, n = 7, o = 5;
+    std::vector<uvec> boxes = Schwarz::boxes(m, n, o, 2, 3, 2);
+
+    ASSERT_EQ(boxes.size(), 12);
+
+    uvec count((m + 2) * (n + 2) * (o + 2), fill::zeros);
+    for (const uvec &box : boxes)
+        count.elem(box) += 1;
+
+    ASSERT_TRUE(all(count == 1)) << "Boxes must partition the grid";
+}
+
+TEST(SchwarzTests, RestrictedGMRES) {
+    int m = 40, n = 40;
+    sp_mat A = dirichlet_2d(2, m, n);
+    vec b = linspace(0, 1, A.n_rows);
+
+    vec reference = LinearSolver::spsolve(A, b, "eigen-lu");
+
+    Schwarz M(A, Schwarz::boxes(m, n, 2, 2), 2, Schwarz::RESTRICTED);
+    ASSERT_EQ(M.size(), 4);
+
+    vec x;
+    KrylovInfo info = Krylov::gmres(Krylov::op(A), b, x, M.preconditioner(),
+                                    1e-10, 500);
+    ASSERT_TRUE(info.converged);
+    ASSERT_LT(norm(x - reference), 1e-7 * norm(reference));
+
+    vec y;
+    KrylovInfo jacobi = Krylov::gmres(Krylov::op(A), b, y, Krylov::jacobi(A),
+                                      1e-10, 500);
+    ASSERT_LT(info.iterations, jacobi.iterations);
+}
+
+TEST(SchwarzTests, AdditiveCG) {
+    int m = 30, n = 30;
+    WeightedLaplacian S(2, m, 1.0 / m, n, 1.0 / n, 1, 1);
+    vec b = linspace(1, 2, S.n_rows);
+
+    vec reference = LinearSolver::spsolve(S, b, "eigen-lu");
+
+    Schwarz M(S, Schwarz::boxes(m, n, 3, 2), 1, Schwarz::ADDITIVE);
+
+    vec x;
+    KrylovInfo info = Krylov::cg(Krylov::op(S), b, x, M.preconditioner());
+    ASSERT_TRUE(info.converged);
+    ASSERT_LT(norm(x - reference), 1e-7 * norm(reference));
+}
+
+TEST(SchwarzTests, Update) {
+    int m = 20, n = 20;
+    sp_mat A = dirichlet_2d(2, m, n);
+    vec b(A.n_rows, fill::ones);
+
+    Schwarz M(A, Schwarz::boxes(m, n, 2, 2));
+
+    // Same pattern, new values, as in an implicit time step
+    sp_mat B = A - 10 * speye(A.n_rows, A.n_cols);
+    M.update(B);
+
+    vec x;
+    KrylovInfo info = Krylov::gmres(Krylov::op(B), b, x, M.preconditioner());
+    ASSERT_TRUE(info.converged);
+    ASSERT_LT(norm(B * x - b), 1e-8 * norm(b));
+}
+
+TEST(SchwarzTests, Backend) {
+    int m = 12;
+    Laplacian L(2, m, m, m, 1.0 / m, 1.0 / m, 1.0 / m);
+    RobinBC BC(2, m, 1.0 / m, m, 1.0 / m, m, 1.0 / m, 1, 0);
+    sp_mat A = L + BC;
+    vec b = linspace(0, 1, A.n_rows);
+
+    SolverOptions opts;
+    opts.subdomains = 4;
+
+    auto solver = LinearSolver::create("schwarz", opts);
+    solver->factorise(A);
+    vec x = solver->solve(b);
+
+    ASSERT_LE(solver->stats().residual, opts.tol);
+    ASSERT_LT(norm(A * x - b), 1e-8 * norm(b));
+}